@@ -0,0 +1,57 @@
+#ifndef BACKDOOR_H
+#define BACKDOOR_H
+
+#include <chrono>
+#include <cstdint>
+#include "MaskBoard.hpp"
+
+// Smallest set of cells whose values, once revealed, let the logical pipeline
+// (singles and intersections) solve a puzzle: the "reveal a cell" assist.
+//
+// The search does not drive the technique pipeline: it tests sets on a MaskBoard,
+// which reaches the same fixed point, so testing one set costs a few microseconds.
+// Sets are tried by increasing size; each size is searched depth-first, every reveal
+// starting from the board already propagated after the previous ones, and cells that
+// earlier reveals already solved are skipped.
+class BackdoorSearch
+{
+public:
+  enum Status {
+    FOUND,      // cells()/digits() hold a smallest set (empty if no reveal is needed)
+    NOT_FOUND,  // no set of at most maxCells cells
+    TIMED_OUT,  // the deadline passed before a set was found
+    INVALID     // conflicting givens or no solution
+  };
+
+  static constexpr int MAX_CELLS = 81;
+
+  // values: 81 givens (0 = empty). maxCells 0 = no limit but the deadline.
+  Status run(const Digit values[81], int maxCells, std::chrono::steady_clock::time_point deadline);
+
+  int size() const { return count; }
+  Index cell(int k) const { return cells[k]; }
+  Digit digit(int k) const { return digits[k]; }
+
+  // sets tested by the last run (propagations from a reveal)
+  uint64_t tested() const { return tests; }
+
+private:
+  bool searchDepth(const MaskBoard &st, int depth, int from);
+
+  MaskBoard start;
+  Digit solution[81];
+  Index order[81];
+  int orderSize = 0;
+
+  Index chosen[MAX_CELLS];
+  Index cells[MAX_CELLS];
+  Digit digits[MAX_CELLS];
+  int count = 0;
+  int target = 0;
+  uint64_t tests = 0;
+
+  std::chrono::steady_clock::time_point deadline;
+  bool timedOut = false;
+};
+
+#endif // BACKDOOR_H
@@ -0,0 +1,43 @@
+#ifndef BOARD_ANALYSIS_H
+#define BOARD_ANALYSIS_H
+
+#include <cstdint>
+#include "SudokuBoard.hpp"
+#include "utils.hpp"
+
+// Derived data shared by all techniques of a solver pass.
+//
+// Built lazily on first use and rebuilt only when the board version changes,
+// so several techniques (and a technique resumed after the board moved on)
+// never recompute the same "where can digit d go in unit u" scan.
+//
+// Units are numbered 0..8 boxes, 9..17 rows, 18..26 columns. Positions inside a
+// unit are bit k of a 9-bit mask, k being the index in unitCells(unit).
+// Only unsolved cells count as positions.
+class BoardAnalysis
+{
+public:
+  static constexpr int NUM_UNITS = 27;
+
+  explicit BoardAnalysis(const SudokuBoard &board);
+
+  static const Index *unitCells(int unit);
+
+  // Positions of 'digit' in 'unit' as a 9-bit mask.
+  Mask positions(int unit, Digit digit);
+
+  // Number of candidates of an unsolved cell (0 for solved cells).
+  int candidateCount(Index idx);
+
+private:
+  void refresh();
+
+  const SudokuBoard &board;
+  uint32_t builtVersion;
+  bool built;
+
+  Mask pos[NUM_UNITS][9];   // [unit][digit - 1]
+  uint8_t candCount[81];
+};
+
+#endif // BOARD_ANALYSIS_H
@@ -0,0 +1,53 @@
+#ifndef BOARD_BATCH_H
+#define BOARD_BATCH_H
+
+#include <cstdint>
+#include "utils.hpp"
+
+// Puzzle-parallel board: LANES independent Sudokus in structure-of-arrays form,
+// cands[81][LANES], so that one vector operation works on the same cell of every board.
+//
+// Only the cheap, branch-free part of solving lives here: candidate recalculation
+// and naked/hidden single propagation. Lanes that stall need the scalar pipeline.
+//
+// Vectors use the GCC/Clang vector extension, so the same code compiles to AVX2
+// (make SIMD=avx2), AVX-512, SSE2 or WASM SIMD depending on the target flags.
+class BoardBatch
+{
+public:
+  static constexpr int LANES = 16;
+
+  typedef uint16_t LaneMask __attribute__((vector_size(LANES * sizeof(uint16_t))));
+
+  BoardBatch();
+
+  // Loads an 81-char puzzle ('1'..'9' given, '0' or '.' empty) into 'lane'.
+  // Returns 0 if the string is malformed or the givens conflict (the lane is left empty).
+  int load(int lane, const char *in81);
+
+  // Marks 'lane' as unused: it is kept solved-empty and ignored by propagation results.
+  void clear(int lane);
+
+  // Runs candidate elimination plus naked and hidden singles on all lanes until
+  // no lane changes any more, then records which lanes reached a contradiction.
+  void propagate();
+
+  bool isSolved(int lane) const;
+
+  // True if the last propagate() found 'lane' broken: an empty cell without candidates,
+  // a digit placed twice in a unit or left without a place in a unit, or two digits
+  // forced into one cell. The singles of such a lane were applied all at once, not in
+  // the scalar pipeline's order, so its board must not be used. Meaningless for a
+  // cleared lane.
+  bool isContradicted(int lane) const;
+
+  // Copies one lane out in the SudokuBoard buffer layout.
+  void exportLane(int lane, Digit *values, Mask *cands) const;
+
+private:
+  LaneMask placed[81];  // bit of the placed digit, 0 if empty
+  LaneMask cands[81];   // 9-bit candidate mask (== placed for solved cells)
+  LaneMask broken;      // non-zero in the lanes isContradicted() reports
+};
+
+#endif // BOARD_BATCH_H
@@ -22,6 +22,9 @@ enum class ReasonId : uint8_t {
   BoxLineReduction = 7
 };
 
+// highest ReasonId, keep updated when adding reasons
+static constexpr ReasonId REASON_ID_MAX = ReasonId::BoxLineReduction;
+
 // one operation = set a value or remove a candidate
 struct Operation {
   Index idx;
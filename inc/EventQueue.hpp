@@ -2,6 +2,7 @@
 #define EVENT_QUEUE_H
 
 #include <queue>
+#include <vector>
 #include "Event.hpp"
 #include "SudokuBoard.hpp"
 
@@ -20,6 +21,9 @@ public:
 
   bool empty() const;
 
+  // copies the pending events in FIFO order (for snapshots)
+  void copyTo(std::vector<Event> &events) const;
+
 private:
   std::queue<Event> q;
 };
@@ -0,0 +1,90 @@
+#ifndef GRID_SAMPLER_H
+#define GRID_SAMPLER_H
+
+#include <cstdint>
+#include "utils.hpp"
+
+class SudokuBoard;
+
+// Seedable pseudo-random generator (xoshiro256**, seeded through splitmix64):
+// the same sequence for a seed on every platform and standard library, unlike
+// the distributions of <random>.
+class SudorixRng
+{
+public:
+  explicit SudorixRng(uint64_t seed = 0) { reseed(seed); }
+
+  void reseed(uint64_t seed);
+  uint64_t next();
+
+  // Uniform in [0, n), n > 0, without modulo bias.
+  uint32_t below(uint32_t n);
+
+  // Uniform in [0, 1).
+  double unit() { return (double)(next() >> 11) * (1.0 / 9007199254740992.0); }
+
+private:
+  uint64_t s[4];
+};
+
+// Random solved grids for the generator and for property tests.
+//
+// Plain randomized backtracking is fast but biased: grids with more dead ends on
+// their way come out less often. The sampler is instead a Markov chain over solved
+// grids whose stationary distribution is uniform, built from three moves that each
+// keep the uniform distribution:
+//   - jump (every jumpEvery grids): an independence Metropolis-Hastings step. A grid
+//     is proposed by a random fill (randomFill) whose probability q is known, and
+//     accepted with probability min(1, q(current) / q(proposed)). This is what makes
+//     the chain forget where it was: swaps alone mix far too slowly;
+//   - swap: pick a cell c and a digit w other than its digit v; the v/w cells reachable
+//     from c through rows, columns and boxes (one v and one w in each unit) can trade
+//     digits and stay a valid grid. The same move leads back (any cell of the set with
+//     the other digit), so the proposal is symmetric;
+//   - symmetry (every grid): a uniformly drawn relabelling of the digits, band/stack and
+//     row/column permutation and transposition.
+// Consecutive grids are therefore not independent: they tend to share their symmetry
+// class between jumps (jumpEvery = 1 for the least correlated stream, 0 disables jumps
+// and with them the mixing). The same seed gives the same sequence.
+class GridSampler
+{
+public:
+  explicit GridSampler(uint64_t seed = 0, int swapsPerGrid = 2, int jumpEvery = 64);
+
+  // Writes the next grid (81 digits 1..9).
+  void next(Digit grid[81]);
+
+  // Loads the next grid into board as a solved board.
+  void next(SudokuBoard &board);
+
+  // Random fill: repeatedly takes the open cell with the fewest candidates (lowest
+  // index on ties) and gives it one of them at random. Writes a grid and returns
+  // log(1 / q), q being the probability of this fill, or -1 on a dead end (no grid).
+  static double randomFill(SudorixRng &rng, Digit grid[81]);
+
+  // log(1 / q) of the fill that produces 'grid' (a solved grid).
+  static double fillLogWeight(const Digit grid[81]);
+
+  static constexpr int BURN_IN_JUMPS = 16;
+
+  // jumps proposed / accepted so far
+  uint64_t jumpsProposed() const { return proposed; }
+  uint64_t jumpsAccepted() const { return accepted; }
+
+private:
+  void jumpStep();
+  void swapStep();
+  void symmetryStep();
+  void indexColumns();
+
+  SudorixRng rng;
+  Digit state[81];
+  int8_t column[10][9];  // column of digit d in row r
+  int swapsPerGrid;
+  int jumpEvery;
+  int sinceJump = 0;
+  uint64_t proposed = 0;
+  uint64_t accepted = 0;
+};
+
+#endif // GRID_SAMPLER_H
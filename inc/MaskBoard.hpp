@@ -0,0 +1,37 @@
+#ifndef MASK_BOARD_H
+#define MASK_BOARD_H
+
+#include "utils.hpp"
+
+// Bare-mask board for searches that test many boards (reveal sets, removal trials):
+// placed digits and the candidates of the unsolved cells (0 for solved cells, so
+// OR-ing a unit only sees open positions).
+//
+// propagate() reaches the same fixed point as the pipeline's techniques (naked and
+// hidden singles, pointing and claiming) without driving them, so one propagation
+// costs a few microseconds, and snapshot and restore are a struct copy.
+struct MaskBoard {
+  Digit values[81];
+  Mask cands[81];
+  int unsolved;
+
+  // Places the givens (0 = empty). Returns false on a value > 9 or a conflict.
+  bool init(const Digit givens[81]);
+
+  // Places 'digit' in cell 'idx' and removes it from the peers.
+  // Returns false on contradiction (digit not a candidate, or a peer left without candidates).
+  bool place(Index idx, Digit digit);
+
+  // Applies the singles and intersections until nothing changes.
+  // Returns false on contradiction.
+  bool propagate();
+
+  // Depth-first search on a propagated board, branching on the cell with the
+  // fewest candidates. Stops at 'limit' solutions and returns how many were found;
+  // the first one is copied to 'first' (if not null).
+  // 'prefer' (if not null) is a grid whose digit is tried first at every branch: a
+  // known solution of a relaxed puzzle, near which the other solutions tend to lie.
+  int countSolutions(int limit, Digit first[81] = nullptr, const Digit *prefer = nullptr) const;
+};
+
+#endif // MASK_BOARD_H
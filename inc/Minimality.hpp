@@ -0,0 +1,42 @@
+#ifndef MINIMALITY_H
+#define MINIMALITY_H
+
+#include <cstdint>
+#include "MaskBoard.hpp"
+
+// Minimality of a puzzle: it has one solution and loses it when any given is removed.
+//
+// Trials share the solution of the original puzzle. With given g removed, the grid is
+// still a solution; any other solution must differ from it in cell g (otherwise it
+// would solve the original puzzle too). So a trial only looks for one solution with
+// another digit in g: first among the grids that swap two digits of the known solution
+// (a few table walks), then by search with g's digit excluded, trying the known
+// solution's digits first. No trial counts solutions.
+class MinimalityCheck
+{
+public:
+  enum Status {
+    MINIMAL,      // unique solution, every given necessary
+    NOT_MINIMAL,  // unique solution, redundant() lists the givens that can go
+    NOT_UNIQUE,   // no solution or several: solutions() tells which
+    INVALID       // a value > 9 or conflicting givens
+  };
+
+  // givens: 81 values (0 = empty)
+  Status run(const Digit givens[81]);
+
+  int solutions() const { return solutionCount; }  // 0, 1 or 2 (two or more)
+  int givenCount() const { return numGivens; }
+
+  int redundantCount() const { return count; }
+  Index redundant(int k) const { return cells[k]; }
+
+private:
+  Digit solution[81];
+  Index cells[81];
+  int count = 0;
+  int numGivens = 0;
+  int solutionCount = 0;
+};
+
+#endif // MINIMALITY_H
@@ -1,6 +1,7 @@
 #ifndef SUDOKU_BOARD_H
 #define SUDOKU_BOARD_H
 
+#include <cstddef>
 #include <cstdint>
 #include "SudokuCell.hpp"
 
@@ -15,6 +16,31 @@ public:
 
   void exportToBuffers(Digit *values, Mask *cands) const;
 
+  // --- compact binary form ---
+  // 81 solved flags (11 bytes) followed by 81 9-bit candidate masks (92 bytes).
+  static constexpr size_t PACKED_SIZE = 11 + 92;
+
+  void pack(uint8_t *buf) const;
+
+  int unpack(const uint8_t *buf);
+
+  // --- pencilmarks ---
+  // Fixed layout: 9 characters per cell, character k is '1'+k if digit k+1 is a
+  // candidate and '.' (or '0') if not; a solved cell lists only its digit.
+  static constexpr size_t PENCILMARKS_SIZE = 81 * 9;
+
+  // Parses either the fixed layout (the first 729 characters) or a printed candidate
+  // grid: exactly 81 runs of digits 1..9, one per cell, separated by anything else
+  // (spaces, '|', '+', '-', newlines). A cell with one candidate is placed; the other
+  // candidates are kept as written (the board may be mid-solve, with eliminations still
+  // pending), so exporting gives the same text back.
+  // Returns 0 (board unchanged) on malformed text, a cell without candidates or
+  // conflicting values.
+  int importFromPencilmarks(const char *text);
+
+  // Writes PENCILMARKS_SIZE characters in the fixed layout (no terminator).
+  void exportToPencilmarks(char *out) const;
+
   // --- values API ---
   Digit getValue(Index idx) const;
 
@@ -46,13 +72,22 @@ public:
 
   bool isCompletelySolved() const;
 
+  // --- change tracking ---
+  // Bumped by every mutator; lets derived data (BoardAnalysis) know when it is stale.
+  uint32_t getVersion() const;
+
+  // --- candidates from values ---
+  // Rebuilds every candidate mask from the placed values.
+  // Returns false if the values conflict or an empty cell has no candidate left.
+  bool recalcAllCandidatesFromValues();
+
 private:
   // We keep a local copy (owned) so that solver techniques can mutate freely
   SudokuCell cells[81];
 
-  static inline bool isValidIndex(Index idx);
+  uint32_t version = 0;
 
-  bool _recalcAllCandidatesFromValues();
+  static inline bool isValidIndex(Index idx);
 };
 
 #endif // SUDOKU_BOARD_H
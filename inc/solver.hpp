@@ -5,13 +5,87 @@
 
 extern "C"
 {
+  // Return codes of the budgeted calls (0 and 1 keep their usual meaning), and the error
+  // code of the calls that return a count, where 0 is a valid result.
+  enum SudorixStatus {
+    SUDORIX_INVALID_INPUT = -1,
+    SUDORIX_ERROR = 0,
+    SUDORIX_OK = 1,
+    SUDORIX_BUDGET_EXHAUSTED = 2,
+    SUDORIX_CANCELLED = 3
+  };
+
+  // Technique tiers, from the cheapest. A tier enables its techniques and all lower ones.
+  enum SudorixTier {
+    SUDORIX_TIER_ALL = 0,            // no limit
+    SUDORIX_TIER_SINGLES = 1,        // full house, hidden and naked singles
+    SUDORIX_TIER_INTERSECTIONS = 2,  // + locked candidates, box/line reduction
+    SUDORIX_TIER_MAX = SUDORIX_TIER_INTERSECTIONS
+  };
+
+  // Technique selection bits for sudorix_solver_hint_all (bit i = i-th technique in priority order).
+  enum SudorixTechnique {
+    SUDORIX_TECH_ALL = 0,  // every technique
+    SUDORIX_TECH_FULL_HOUSE = 1u << 0,
+    SUDORIX_TECH_HIDDEN_SINGLES = 1u << 1,
+    SUDORIX_TECH_LOCKED_CANDIDATES = 1u << 2,
+    SUDORIX_TECH_NAKED_SINGLES = 1u << 3,
+    SUDORIX_TECH_BOX_LINE_REDUCTION = 1u << 4
+  };
+
+  // Work limits for one call. Every field set to 0 (or null) is unlimited.
+  // The limits and the cancel flag are checked between technique passes.
+  struct SudorixBudget {
+    uint32_t max_steps;            // events applied
+    uint32_t max_technique_evals;  // technique passes run
+    uint64_t deadline_ns;          // wall-clock time, relative to the start of the call
+    const volatile int32_t *cancel; // set to nonzero (from any thread) to stop the call
+  };
+
   int sudorix_solver_full(const char *in81, char *out81);
+
+  int sudorix_solver_full_budget(const char *in81, char *out81, const SudorixBudget *budget);
   
   int sudorix_solver_init_board(const char *in81);
   
   int sudorix_solver_next_step(uint32_t *out, uint32_t out_words);
 
   int sudorix_solver_hint(const uint8_t *values, const uint16_t *cands, uint32_t *out, uint32_t out_words);
+
+  int sudorix_solver_hint_best(const uint8_t *values, const uint16_t *cands, uint32_t *out, uint32_t out_words,
+                               uint32_t max_tier, uint32_t lookahead_us);
+
+  int sudorix_solver_hint_all(const uint8_t *values, const uint16_t *cands, uint32_t techniques,
+                              uint32_t *out, uint32_t out_words, uint32_t *available);
+
+  int sudorix_solver_export_board(uint8_t *values, uint16_t *cands);
+
+  int sudorix_solver_parse_board(const char *in81, uint8_t *values, uint16_t *cands);
+
+  int sudorix_solver_parse_pencilmarks(const char *text, uint8_t *values, uint16_t *cands);
+
+  int sudorix_solver_format_pencilmarks(const uint8_t *values, const uint16_t *cands, char *out729);
+
+  int sudorix_solver_load_board(const uint8_t *values, const uint16_t *cands);
+
+  int sudorix_solver_recalc_candidates(const uint8_t *values, uint16_t *cands);
+
+  int sudorix_solver_clear_peers(const uint8_t *values, uint16_t *cands, uint32_t idx, uint32_t digit);
+
+  int sudorix_solver_check_grid(const uint8_t *values, uint32_t *out, uint32_t out_words);
+
+  int sudorix_solver_run_tier(uint8_t *values, uint16_t *cands, uint32_t max_tier);
+
+  int sudorix_solver_full_batch(const char *in81s, char *out81s, uint32_t count);
+
+  int sudorix_solver_backdoor(const char *in81, uint32_t max_cells, uint32_t budget_us,
+                              uint32_t *out, uint32_t out_words);
+
+  int sudorix_solver_minimality(const char *in81, uint32_t *out, uint32_t out_words);
+
+  int sudorix_solver_snapshot(uint8_t *buf, uint32_t buf_size);
+
+  int sudorix_solver_restore(const uint8_t *buf, uint32_t size);
 } // extern "C"
 
 #endif // SOLVER_H
@@ -0,0 +1,45 @@
+#ifndef TECHNIQUES_H
+#define TECHNIQUES_H
+
+#include <cstddef>
+#include <cstdint>
+#include "SudokuBoard.hpp"
+#include "BoardAnalysis.hpp"
+
+// A technique scans the board and enqueues what it finds (it never mutates the board).
+// 'analysis' holds derived data (digit positions per unit, candidate counts) shared with
+// the other techniques of the same pass.
+// The scan starts at position 'from' (0 = from the beginning) and stops after the first
+// position that enqueued something, returning the position to resume from, or
+// TECHNIQUE_SCAN_DONE when it reached the end.
+typedef uint32_t (*TechniqueFn)(SudokuBoard &board, BoardAnalysis &analysis, uint32_t from);
+
+static constexpr uint32_t TECHNIQUE_SCAN_DONE = UINT32_MAX;
+
+// Called after every technique pass run by the solver pipeline, with the technique
+// number, how many events it enqueued and the time it took.
+typedef void (*TechniquePassHook)(void *ctx, size_t technique, size_t produced, uint64_t ns);
+
+// =========================================================
+// Technique introspection (native tools and benchmarks)
+// =========================================================
+
+// Techniques are numbered in the priority order used by the solver.
+size_t sudorix_technique_count();
+
+const char *sudorix_technique_name(size_t i);
+
+// Lowest SudorixTier that enables technique i.
+uint32_t sudorix_technique_tier(size_t i);
+
+// Runs a complete scan of technique i over 'board' with 'analysis' (built on 'board', and
+// kept across calls by a caller timing the scan alone), on a scratch event queue of the
+// calling thread. Returns the number of events enqueued; the queue of a step-by-step
+// session running on the thread is left untouched.
+size_t sudorix_technique_run(size_t i, SudokuBoard &board, BoardAnalysis &analysis);
+
+// Installs a pass hook for the calling thread (nullptr to remove it).
+// Passes are only timed while a hook is installed.
+void sudorix_set_technique_pass_hook(TechniquePassHook hook, void *ctx);
+
+#endif // TECHNIQUES_H
@@ -115,4 +115,9 @@ inline uint8_t bitToDigitSingle(Mask mask) {
 #endif
 }
 
+inline int lowestBitIndex(Mask mask) {
+  // position (0..8) of the lowest set bit, mask must not be 0
+  return (int)bitToDigitSingle((Mask)(mask & (Mask)(0u - mask))) - 1;
+}
+
 #endif // UTILS_H
@@ -0,0 +1,88 @@
+#include "Backdoor.hpp"
+
+// =========================================================
+// BackdoorSearch
+// =========================================================
+
+using Clock = std::chrono::steady_clock;
+
+bool BackdoorSearch::searchDepth(const MaskBoard &st, int level, int from) {
+  for (int pos = from; pos < orderSize; pos++) {
+    const Index c = order[pos];
+    if (st.values[c]) {
+      continue;  // solved by the reveals already chosen: same set as a smaller one
+    }
+    if ((++tests & 63) == 0 && Clock::now() >= deadline) {
+      timedOut = true;
+      return false;
+    }
+
+    MaskBoard next = st;
+    chosen[level] = c;
+    if (!next.place(c, solution[c]) || !next.propagate()) {
+      continue;  // not reachable with the solution's own digits
+    }
+    if (next.unsolved == 0) {
+      // every smaller size was searched exhaustively, so this is a smallest set
+      count = level + 1;
+      for (int k = 0; k < count; k++) {
+        cells[k] = chosen[k];
+        digits[k] = solution[chosen[k]];
+      }
+      return true;
+    }
+    if (level + 1 < target && searchDepth(next, level + 1, pos + 1)) {
+      return true;
+    }
+    if (timedOut) {
+      return false;
+    }
+  }
+  return false;
+}
+
+BackdoorSearch::Status BackdoorSearch::run(const Digit values[81], int maxCells, Clock::time_point until) {
+  count = 0;
+  tests = 0;
+  timedOut = false;
+  deadline = until;
+
+  if (!start.init(values) || !start.propagate()) {
+    return INVALID;
+  }
+  if (start.unsolved == 0) {
+    return FOUND;
+  }
+  if (start.countSolutions(1, solution) == 0) {
+    return INVALID;
+  }
+
+  // Cells with more candidates first: their reveal removes a digit from more peers.
+  orderSize = 0;
+  for (Index i = 0; i < 81; i++) {
+    if (start.values[i] == 0) {
+      order[orderSize++] = i;
+    }
+  }
+  for (int a = 1; a < orderSize; a++) {
+    const Index c = order[a];
+    const int n = countBits9(start.cands[c]);
+    int b = a;
+    while (b > 0 && countBits9(start.cands[order[b - 1]]) < n) {
+      order[b] = order[b - 1];
+      b--;
+    }
+    order[b] = c;
+  }
+
+  const int limit = (maxCells > 0 && maxCells < start.unsolved) ? maxCells : start.unsolved;
+  for (target = 1; target <= limit; target++) {
+    if (searchDepth(start, 0, 0)) {
+      return FOUND;
+    }
+    if (timedOut) {
+      return TIMED_OUT;
+    }
+  }
+  return NOT_FOUND;
+}
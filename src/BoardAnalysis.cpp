@@ -0,0 +1,61 @@
+#include "BoardAnalysis.hpp"
+
+// =========================================================
+// BoardAnalysis
+// =========================================================
+
+static const Index (*const UNIT_CELLS[3])[9] = { BOX_CELLS, ROW_CELLS, COL_CELLS };
+
+BoardAnalysis::BoardAnalysis(const SudokuBoard &board) : board(board), builtVersion(0), built(false) { }
+
+const Index *BoardAnalysis::unitCells(int unit) {
+  return UNIT_CELLS[unit / 9][unit % 9];
+}
+
+void BoardAnalysis::refresh() {
+  if (built && builtVersion == board.getVersion()) {
+    return;
+  }
+
+  for (int u = 0; u < NUM_UNITS; u++) {
+    for (int d = 0; d < 9; d++) {
+      pos[u][d] = 0;
+    }
+  }
+
+  for (int i = 0; i < 81; i++) {
+    if (board.isSolved(i)) {
+      candCount[i] = 0;
+      continue;
+    }
+    const int r = idxRow(i);
+    const int c = idxCol(i);
+    const int b = idxBox(i);
+    const Mask inBox = (Mask)(1u << ((r % 3) * 3 + (c % 3)));
+    const Mask inRow = (Mask)(1u << c);
+    const Mask inCol = (Mask)(1u << r);
+
+    Mask m = board.getCandidateMask(i);
+    candCount[i] = countBits9(m);
+    while (m) {
+      const int d = lowestBitIndex(m);
+      m &= (Mask)(m - 1);
+      pos[b][d] |= inBox;
+      pos[9 + r][d] |= inRow;
+      pos[18 + c][d] |= inCol;
+    }
+  }
+
+  builtVersion = board.getVersion();
+  built = true;
+}
+
+Mask BoardAnalysis::positions(int unit, Digit digit) {
+  refresh();
+  return pos[unit][digit - 1];
+}
+
+int BoardAnalysis::candidateCount(Index idx) {
+  refresh();
+  return candCount[idx];
+}
@@ -0,0 +1,196 @@
+#include "BoardBatch.hpp"
+
+// =========================================================
+// BoardBatch
+// =========================================================
+
+typedef BoardBatch::LaneMask LaneMask;
+
+static constexpr int LANES = BoardBatch::LANES;
+
+// all units: rows, columns, boxes
+static const Index (*const UNITS[3])[9] = { ROW_CELLS, COL_CELLS, BOX_CELLS };
+
+// helpers take vectors by reference: passing them by value changes the ABI with/without AVX
+static inline void splat(LaneMask &m, uint16_t v) {
+  for (int l = 0; l < LANES; l++) {
+    m[l] = v;
+  }
+}
+
+static inline bool anyLane(const LaneMask &m) {
+  uint16_t acc = 0;
+  for (int l = 0; l < LANES; l++) {
+    acc |= m[l];
+  }
+  return acc != 0;
+}
+
+BoardBatch::BoardBatch() {
+  for (int i = 0; i < 81; i++) {
+    splat(placed[i], 0);
+    splat(cands[i], 0);
+  }
+  splat(broken, 0);
+}
+
+int BoardBatch::load(int lane, const char *in81) {
+  Mask rowUsed[9] = {0};
+  Mask colUsed[9] = {0};
+  Mask boxUsed[9] = {0};
+  Mask bits[81];
+
+  for (int i = 0; i < 81; i++) {
+    const char ch = in81[i];
+    if (ch >= '1' && ch <= '9') {
+      const Mask bit = digitToBit((Digit)(ch - '0'));
+      const int r = idxRow(i);
+      const int c = idxCol(i);
+      const int b = idxBox(i);
+      if ((rowUsed[r] | colUsed[c] | boxUsed[b]) & bit) {
+        clear(lane);
+        return 0;
+      }
+      rowUsed[r] |= bit;
+      colUsed[c] |= bit;
+      boxUsed[b] |= bit;
+      bits[i] = bit;
+    } else if (ch == '0' || ch == '.') {
+      bits[i] = 0;
+    } else {
+      clear(lane);
+      return 0;
+    }
+  }
+
+  for (int i = 0; i < 81; i++) {
+    placed[i][lane] = bits[i];
+    cands[i][lane] = bits[i] ? bits[i] : (Mask)0x1FFu;
+  }
+  return 1;
+}
+
+void BoardBatch::clear(int lane) {
+  // an unused lane looks like a finished board, so it never causes work
+  for (int i = 0; i < 81; i++) {
+    placed[i][lane] = 0x1FFu;
+    cands[i][lane] = 0x1FFu;
+  }
+}
+
+void BoardBatch::propagate() {
+  LaneMask zero;
+  LaneMask all;
+  splat(zero, 0);
+  splat(all, 0x1FFu);
+  LaneMask bad = zero;
+
+  bool changed = true;
+  while (changed) {
+    LaneMask delta = zero;
+
+    // 1) remove placed digits from the peers (same as recalculating candidates from values)
+    LaneMask used[3][9];
+    for (int kind = 0; kind < 3; kind++) {
+      for (int u = 0; u < 9; u++) {
+        LaneMask m = zero;
+        for (int k = 0; k < 9; k++) {
+          m |= placed[UNITS[kind][u][k]];
+        }
+        used[kind][u] = m;
+      }
+    }
+    for (int i = 0; i < 81; i++) {
+      const LaneMask peers = used[0][idxRow(i)] | used[1][idxCol(i)] | used[2][idxBox(i)];
+      const LaneMask next = cands[i] & (~peers | placed[i]);
+      delta |= next ^ cands[i];
+      cands[i] = next;
+    }
+
+    // 2) naked singles: exactly one candidate left in an empty cell
+    for (int i = 0; i < 81; i++) {
+      const LaneMask c = cands[i];
+      const LaneMask single = (LaneMask)((c & (c - 1)) == zero) & (LaneMask)(c != zero) &
+                              (LaneMask)(placed[i] == zero);
+      const LaneMask next = placed[i] | (c & single);
+      delta |= next ^ placed[i];
+      placed[i] = next;
+    }
+
+    // 3) hidden singles: a digit with one place left in a unit narrows that cell to it,
+    //    the next round places it as a naked single
+    for (int kind = 0; kind < 3; kind++) {
+      for (int u = 0; u < 9; u++) {
+        const Index *unit = UNITS[kind][u];
+        LaneMask once = zero;
+        LaneMask twice = zero;
+        LaneMask done = zero;
+        for (int k = 0; k < 9; k++) {
+          const LaneMask c = cands[unit[k]];
+          twice |= once & c;
+          once |= c;
+          done |= placed[unit[k]];
+        }
+        const LaneMask hidden = once & ~twice & ~done & all;
+        if (!anyLane(hidden)) {
+          continue;
+        }
+        for (int k = 0; k < 9; k++) {
+          const Index idx = unit[k];
+          const LaneMask h = cands[idx] & hidden;
+          const LaneMask take = (LaneMask)(h != zero) & (LaneMask)(placed[idx] == zero);
+          bad |= take & (h & (h - 1));  // two digits hidden in the same cell
+          const LaneMask next = (cands[idx] & ~take) | (h & take);
+          delta |= next ^ cands[idx];
+          cands[idx] = next;
+        }
+      }
+    }
+
+    changed = anyLane(delta);
+  }
+
+  // 4) contradictions, checked once on the final state (they never go away): an empty cell
+  //    without candidates (a placed cell keeps its digit as candidate), a digit placed
+  //    twice in a unit, a digit with no place left in a unit
+  for (int i = 0; i < 81; i++) {
+    bad |= (LaneMask)(cands[i] == zero);
+  }
+  for (int kind = 0; kind < 3; kind++) {
+    for (int u = 0; u < 9; u++) {
+      const Index *unit = UNITS[kind][u];
+      LaneMask seen = zero;
+      LaneMask twice = zero;
+      LaneMask anywhere = zero;
+      for (int k = 0; k < 9; k++) {
+        const LaneMask p = placed[unit[k]];
+        twice |= seen & p;
+        seen |= p;
+        anywhere |= cands[unit[k]];
+      }
+      bad |= twice | (all & ~anywhere);
+    }
+  }
+  broken = bad;
+}
+
+bool BoardBatch::isSolved(int lane) const {
+  for (int i = 0; i < 81; i++) {
+    if (placed[i][lane] == 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool BoardBatch::isContradicted(int lane) const {
+  return broken[lane] != 0;
+}
+
+void BoardBatch::exportLane(int lane, Digit *values, Mask *cands) const {
+  for (int i = 0; i < 81; i++) {
+    const Mask p = placed[i][lane];
+    values[i] = (p != 0 && countBits9(p) == 1) ? bitToDigitSingle(p) : 0;
+    cands[i] = this->cands[i][lane];
+  }
+}
@@ -40,3 +40,11 @@ size_t EventQueue::size() const {
 bool EventQueue::empty() const {
   return q.empty();
 }
+
+void EventQueue::copyTo(std::vector<Event> &events) const {
+  std::queue<Event> tmp = q;
+  while (!tmp.empty()) {
+    events.push_back(tmp.front());
+    tmp.pop();
+  }
+}
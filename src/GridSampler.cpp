@@ -0,0 +1,311 @@
+#include <cmath>
+
+#include "GridSampler.hpp"
+#include "SudokuBoard.hpp"
+
+// =========================================================
+// SudorixRng
+// =========================================================
+
+namespace {
+
+uint64_t splitmix64(uint64_t &x) {
+  uint64_t z = (x += 0x9E3779B97F4A7C15ull);
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+  return z ^ (z >> 31);
+}
+
+inline uint64_t rotl(uint64_t x, int k) {
+  return (x << k) | (x >> (64 - k));
+}
+
+} // namespace
+
+void SudorixRng::reseed(uint64_t seed) {
+  uint64_t x = seed;
+  for (uint64_t &word : s) {
+    word = splitmix64(x);
+  }
+}
+
+uint64_t SudorixRng::next() {
+  const uint64_t result = rotl(s[1] * 5, 7) * 9;
+  const uint64_t t = s[1] << 17;
+  s[2] ^= s[0];
+  s[3] ^= s[1];
+  s[1] ^= s[2];
+  s[0] ^= s[3];
+  s[2] ^= t;
+  s[3] = rotl(s[3], 45);
+  return result;
+}
+
+uint32_t SudorixRng::below(uint32_t n) {
+  // multiply-shift with rejection of the few low products that would bias it (Lemire)
+  uint64_t m = (next() >> 32) * n;
+  uint32_t low = (uint32_t)m;
+  if (low < n) {
+    const uint32_t threshold = (0u - n) % n;
+    while (low < threshold) {
+      m = (next() >> 32) * n;
+      low = (uint32_t)m;
+    }
+  }
+  return (uint32_t)(m >> 32);
+}
+
+// =========================================================
+// GridSampler
+// =========================================================
+
+namespace {
+
+struct FillTables {
+  Index peers[81][20];
+  double logs[10];
+
+  FillTables() {
+    for (Index i = 0; i < 81; i++) {
+      int n = 0;
+      for (Index j = 0; j < 81; j++) {
+        if (j != i && (idxRow(j) == idxRow(i) || idxCol(j) == idxCol(i) || idxBox(j) == idxBox(i))) {
+          peers[i][n++] = j;
+        }
+      }
+    }
+    for (int n = 0; n < 10; n++) {
+      logs[n] = n ? std::log((double)n) : 0.0;
+    }
+  }
+};
+
+const FillTables &fillTables() {
+  static const FillTables t;
+  return t;
+}
+
+// The fill of randomFill, or with 'replay' its replay on a known grid: same choice of
+// cells, the digits taken from 'replay' instead of the generator.
+// Open cells are kept in 81-bit sets by number of candidates, so the next cell
+// (fewest candidates, lowest index) is found without scanning the board; the numbers
+// are kept per cell too, as popcount is a library call on the baseline x86-64 ISA.
+double fill(SudorixRng *rng, Digit grid[81], const Digit *replay) {
+  const FillTables &t = fillTables();
+  Mask cands[81];
+  uint8_t counts[81];
+  uint64_t byCount[10][2] = {};
+  for (int i = 0; i < 81; i++) {
+    cands[i] = 0x1FF;
+    counts[i] = 9;
+  }
+  byCount[9][0] = ~0ull;
+  byCount[9][1] = (1ull << 17) - 1;
+
+  double logWeight = 0.0;
+  for (int placed = 0; placed < 81; placed++) {
+    int n = 0;
+    while (n < 10 && (byCount[n][0] | byCount[n][1]) == 0) {
+      n++;
+    }
+    if (n == 0) {
+      return -1.0;  // an open cell without candidates
+    }
+    const Index idx = byCount[n][0] ? (Index)__builtin_ctzll(byCount[n][0])
+                                    : (Index)(64 + __builtin_ctzll(byCount[n][1]));
+    byCount[n][idx >> 6] &= ~(1ull << (idx & 63));
+
+    Mask bit;
+    if (replay) {
+      bit = digitToBit(replay[idx]);
+      if ((cands[idx] & bit) == 0) {
+        return -1.0;
+      }
+    } else {
+      bit = cands[idx];
+      for (uint32_t k = rng->below((uint32_t)n); k > 0; k--) {
+        bit &= (Mask)(bit - 1);
+      }
+      bit &= (Mask)(0u - bit);
+    }
+    grid[idx] = bitToDigitSingle(bit);
+    cands[idx] = 0;
+    logWeight += t.logs[n];
+
+    for (Index p : t.peers[idx]) {
+      if (cands[p] & bit) {
+        const int c = counts[p]--;
+        cands[p] &= (Mask)~bit;
+        const uint64_t pbit = 1ull << (p & 63);
+        byCount[c][p >> 6] &= ~pbit;
+        byCount[c - 1][p >> 6] |= pbit;
+      }
+    }
+  }
+  return logWeight;
+}
+
+// Permutation number 'code' (0..5) of 3 items.
+const int PERM3[6][3] = {{0, 1, 2}, {0, 2, 1}, {1, 0, 2}, {1, 2, 0}, {2, 0, 1}, {2, 1, 0}};
+
+// Permutation of the 9 rows (or columns) that keeps bands (stacks) together, from
+// 'code' in [0, 6^4): one permutation of the bands and one in each band.
+void lineMap(uint32_t code, int map[9]) {
+  const int *bands = PERM3[code % 6];
+  code /= 6;
+  for (int b = 0; b < 3; b++) {
+    const int *lines = PERM3[code % 6];
+    code /= 6;
+    for (int k = 0; k < 3; k++) {
+      map[b * 3 + k] = bands[b] * 3 + lines[k];
+    }
+  }
+}
+
+} // namespace
+
+GridSampler::GridSampler(uint64_t seed, int swaps, int jumpAfter)
+    : rng(seed), swapsPerGrid(swaps), jumpEvery(jumpAfter) {
+  while (randomFill(rng, state) < 0) {
+  }
+  indexColumns();
+  for (int k = 0; k < BURN_IN_JUMPS; k++) {
+    jumpStep();
+  }
+}
+
+double GridSampler::randomFill(SudorixRng &rng, Digit grid[81]) {
+  return fill(&rng, grid, nullptr);
+}
+
+double GridSampler::fillLogWeight(const Digit grid[81]) {
+  Digit copy[81];
+  return fill(nullptr, copy, grid);
+}
+
+void GridSampler::jumpStep() {
+  Digit proposal[81];
+  double proposalLogWeight;
+  do {
+    proposalLogWeight = randomFill(rng, proposal);
+  } while (proposalLogWeight < 0);
+  proposed++;
+
+  // uniform target: accept with min(1, q(state) / q(proposal))
+  const double delta = proposalLogWeight - fillLogWeight(state);
+  if (delta >= 0 || rng.unit() < std::exp(delta)) {
+    for (int i = 0; i < 81; i++) {
+      state[i] = proposal[i];
+    }
+    indexColumns();
+    accepted++;
+  }
+}
+
+void GridSampler::swapStep() {
+  const Index start = (Index)rng.below(81);
+  const Digit v = state[start];
+  Digit w = (Digit)(1 + rng.below(8));
+  if (w >= v) {
+    w++;
+  }
+
+  // Each row holds one v and one w, and the set takes both or neither, so it is a set
+  // of rows: row r pulls in the rows holding the other digit in the columns and boxes
+  // of its two cells, four rows found in tables of where v and w sit per column and box.
+  const int8_t *colV = column[v];
+  const int8_t *colW = column[w];
+  int rowOfV[9];  // row of v in column c
+  int rowOfW[9];
+  int boxRowOfV[9];  // row of v in box b
+  int boxRowOfW[9];
+  for (int r = 0; r < 9; r++) {
+    rowOfV[colV[r]] = r;
+    rowOfW[colW[r]] = r;
+    boxRowOfV[(r / 3) * 3 + colV[r] / 3] = r;
+    boxRowOfW[(r / 3) * 3 + colW[r] / 3] = r;
+  }
+
+  int rows = 1 << idxRow(start);
+  int pending = rows;
+  while (pending) {
+    const int r = __builtin_ctz((unsigned)pending);
+    pending &= pending - 1;
+    const int band = (r / 3) * 3;
+    const int linked = (1 << rowOfW[colV[r]]) | (1 << rowOfV[colW[r]]) |
+                       (1 << boxRowOfW[band + colV[r] / 3]) | (1 << boxRowOfV[band + colW[r] / 3]);
+    pending |= linked & ~rows;
+    rows |= linked;
+  }
+
+  while (rows) {
+    const int r = __builtin_ctz((unsigned)rows);
+    rows &= rows - 1;
+    const int8_t a = colV[r];
+    column[v][r] = colW[r];
+    column[w][r] = a;
+    state[r * 9 + column[v][r]] = v;
+    state[r * 9 + column[w][r]] = w;
+  }
+}
+
+void GridSampler::indexColumns() {
+  for (Index i = 0; i < 81; i++) {
+    column[state[i]][idxRow(i)] = (int8_t)idxCol(i);
+  }
+}
+
+void GridSampler::symmetryStep() {
+  // two draws for the whole symmetry: line permutations and transposition, then digits
+  uint32_t code = rng.below(6u * 6 * 6 * 6 * 6 * 6 * 6 * 6 * 2);
+  int rowMap[9];
+  int colMap[9];
+  lineMap(code % 1296, rowMap);
+  code /= 1296;
+  lineMap(code % 1296, colMap);
+  const bool transpose = (code / 1296) != 0;
+
+  Digit relabel[10] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+  uint32_t digits = rng.below(362880);  // 9!, decoded as a Fisher-Yates sequence
+  for (int i = 9; i > 1; i--) {
+    const int j = 1 + (int)(digits % (uint32_t)i);
+    digits /= (uint32_t)i;
+    const Digit tmp = relabel[i];
+    relabel[i] = relabel[j];
+    relabel[j] = tmp;
+  }
+
+  Digit out[81];
+  for (int r = 0; r < 9; r++) {
+    for (int c = 0; c < 9; c++) {
+      const int src = transpose ? colMap[c] * 9 + rowMap[r] : rowMap[r] * 9 + colMap[c];
+      const Digit d = relabel[state[src]];
+      out[r * 9 + c] = d;
+      column[d][r] = (int8_t)c;
+    }
+  }
+  for (int i = 0; i < 81; i++) {
+    state[i] = out[i];
+  }
+}
+
+void GridSampler::next(Digit grid[81]) {
+  if (jumpEvery > 0 && ++sinceJump >= jumpEvery) {
+    jumpStep();
+    sinceJump = 0;
+  }
+  for (int k = 0; k < swapsPerGrid; k++) {
+    swapStep();
+  }
+  symmetryStep();
+  for (int i = 0; i < 81; i++) {
+    grid[i] = state[i];
+  }
+}
+
+void GridSampler::next(SudokuBoard &board) {
+  Digit grid[81];
+  Mask cands[81] = {};
+  next(grid);
+  board.importFromBuffers(grid, cands);
+}
@@ -0,0 +1,259 @@
+#include "MaskBoard.hpp"
+
+// =========================================================
+// MaskBoard
+// =========================================================
+
+namespace {
+
+// Cell tables, built once.
+struct Tables {
+  Index units[27][9];  // boxes, rows, columns
+  Index peers[81][20];
+
+  // Box/line intersections: the 3 cells shared by a box and a row or column,
+  // the 6 other cells of the line and the 6 other cells of the box.
+  struct Segment {
+    Index cells[3];
+    Index lineRest[6];
+    Index boxRest[6];
+  };
+  Segment segments[54];
+
+  Tables() {
+    for (int u = 0; u < 9; u++) {
+      for (int k = 0; k < 9; k++) {
+        units[u][k] = BOX_CELLS[u][k];
+        units[9 + u][k] = ROW_CELLS[u][k];
+        units[18 + u][k] = COL_CELLS[u][k];
+      }
+    }
+
+    for (Index i = 0; i < 81; i++) {
+      int n = 0;
+      for (Index j = 0; j < 81; j++) {
+        if (j != i && (idxRow(j) == idxRow(i) || idxCol(j) == idxCol(i) || idxBox(j) == idxBox(i))) {
+          peers[i][n++] = j;
+        }
+      }
+    }
+
+    int s = 0;
+    for (int b = 0; b < 9; b++) {
+      for (int byCol = 0; byCol < 2; byCol++) {
+        for (int k = 0; k < 3; k++) {
+          const int line = byCol ? (b % 3) * 3 + k : (b / 3) * 3 + k;
+          const Index *lineCells = byCol ? COL_CELLS[line] : ROW_CELLS[line];
+          Segment &seg = segments[s++];
+          int nSeg = 0;
+          int nLine = 0;
+          int nBox = 0;
+          for (int m = 0; m < 9; m++) {
+            const Index c = lineCells[m];
+            if (idxBox(c) == b) {
+              seg.cells[nSeg++] = c;
+            } else {
+              seg.lineRest[nLine++] = c;
+            }
+          }
+          for (int m = 0; m < 9; m++) {
+            const Index c = BOX_CELLS[b][m];
+            if ((byCol ? idxCol(c) : idxRow(c)) != line) {
+              seg.boxRest[nBox++] = c;
+            }
+          }
+        }
+      }
+    }
+  }
+};
+
+const Tables &tables() {
+  static const Tables t;
+  return t;
+}
+
+} // namespace
+
+bool MaskBoard::place(Index idx, Digit digit) {
+  const Mask bit = digitToBit(digit);
+  if ((cands[idx] & bit) == 0) {
+    return false;
+  }
+  values[idx] = digit;
+  cands[idx] = 0;
+  unsolved--;
+  for (Index p : tables().peers[idx]) {
+    if (cands[p] & bit) {
+      cands[p] &= (Mask)~bit;
+      if (cands[p] == 0) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+namespace {
+
+// Removes 'mask' from the candidates of 'cells'. Returns false on contradiction.
+bool removeFrom(MaskBoard &st, const Index *cells, int n, Mask mask, bool *changed) {
+  for (int k = 0; k < n; k++) {
+    const Index c = cells[k];
+    if (st.cands[c] & mask) {
+      st.cands[c] &= (Mask)~mask;
+      *changed = true;
+      if (st.cands[c] == 0) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+} // namespace
+
+bool MaskBoard::propagate() {
+  const Tables &t = tables();
+  bool changed = true;
+  while (changed && unsolved > 0) {
+    changed = false;
+
+    for (Index i = 0; i < 81; i++) {
+      const Mask m = cands[i];
+      if (m != 0 && (m & (m - 1)) == 0) {
+        if (!place(i, bitToDigitSingle(m))) {
+          return false;
+        }
+        changed = true;
+      }
+    }
+
+    for (int u = 0; u < 27; u++) {
+      const Index *cells = t.units[u];
+      Mask once = 0;
+      Mask twice = 0;
+      Mask placed = 0;
+      for (int k = 0; k < 9; k++) {
+        const Index c = cells[k];
+        if (values[c]) {
+          placed |= digitToBit(values[c]);
+        } else {
+          twice |= (Mask)(once & cands[c]);
+          once |= cands[c];
+        }
+      }
+      if ((Mask)(once | placed) != 0x1FF) {
+        return false;  // a digit has no place left in this unit
+      }
+      Mask hidden = (Mask)(once & ~twice);
+      while (hidden) {
+        const Mask bit = (Mask)(hidden & (Mask)(0u - hidden));
+        hidden &= (Mask)(hidden - 1);
+        for (int k = 0; k < 9; k++) {
+          if (cands[cells[k]] & bit) {
+            if (!place(cells[k], bitToDigitSingle(bit))) {
+              return false;
+            }
+            changed = true;
+            break;
+          }
+        }
+      }
+    }
+    if (changed) {
+      continue;  // singles first, intersections only on a board they leave alone
+    }
+
+    for (const Tables::Segment &seg : t.segments) {
+      const Mask inSeg = (Mask)(cands[seg.cells[0]] | cands[seg.cells[1]] | cands[seg.cells[2]]);
+      if (inSeg == 0) {
+        continue;
+      }
+      Mask inLine = 0;
+      Mask inBox = 0;
+      for (int k = 0; k < 6; k++) {
+        inLine |= cands[seg.lineRest[k]];
+        inBox |= cands[seg.boxRest[k]];
+      }
+      // pointing: digits of the box confined to the segment leave the rest of the line
+      const Mask pointing = (Mask)(inSeg & ~inBox & inLine);
+      if (pointing && !removeFrom(*this, seg.lineRest, 6, pointing, &changed)) {
+        return false;
+      }
+      // claiming: digits of the line confined to the segment leave the rest of the box
+      const Mask claiming = (Mask)(inSeg & ~inLine & inBox);
+      if (claiming && !removeFrom(*this, seg.boxRest, 6, claiming, &changed)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool MaskBoard::init(const Digit givens[81]) {
+  unsolved = 81;
+  for (int i = 0; i < 81; i++) {
+    values[i] = 0;
+    cands[i] = 0x1FF;
+  }
+  for (Index i = 0; i < 81; i++) {
+    if (givens[i] > 9) {
+      return false;
+    }
+    if (givens[i] && !place(i, givens[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+namespace {
+
+// Solutions below 'st' added to 'found', stopping at 'limit'.
+int countFrom(const MaskBoard &st, int limit, int found, Digit *first, const Digit *prefer) {
+  if (st.unsolved == 0) {
+    if (found == 0 && first) {
+      for (int i = 0; i < 81; i++) {
+        first[i] = st.values[i];
+      }
+    }
+    return found + 1;
+  }
+
+  // branch on the unsolved cell with the fewest candidates
+  Index best = -1;
+  int bestCount = 10;
+  for (Index i = 0; i < 81; i++) {
+    if (st.values[i] == 0) {
+      const int n = countBits9(st.cands[i]);
+      if (n < bestCount) {
+        best = i;
+        bestCount = n;
+      }
+    }
+  }
+
+  const Mask preferred = prefer ? (Mask)(st.cands[best] & digitToBit(prefer[best])) : (Mask)0;
+  const Mask passes[2] = {preferred, (Mask)(st.cands[best] & ~preferred)};
+  for (Mask m : passes) {
+    while (m) {
+      const Mask bit = (Mask)(m & (Mask)(0u - m));
+      m &= (Mask)(m - 1);
+      MaskBoard next = st;
+      if (next.place(best, bitToDigitSingle(bit)) && next.propagate()) {
+        found = countFrom(next, limit, found, first, prefer);
+        if (found >= limit) {
+          return found;
+        }
+      }
+    }
+  }
+  return found;
+}
+
+} // namespace
+
+int MaskBoard::countSolutions(int limit, Digit first[81], const Digit *prefer) const {
+  return limit > 0 ? countFrom(*this, limit, 0, first, prefer) : 0;
+}
@@ -0,0 +1,93 @@
+#include "Minimality.hpp"
+
+// =========================================================
+// MinimalityCheck
+// =========================================================
+
+namespace {
+
+// Looks for a second solution that only swaps digit v = solution[g] with another digit w:
+// the smallest set of v/w cells holding g that every row, column and box meets in both or
+// neither of its v and w cells. Swapping v and w there gives another grid; if no given
+// other than g lies in the set, that grid solves the puzzle without g.
+bool hasSwapSolution(const Digit solution[81], const Digit givens[81], Index g) {
+  const Digit v = solution[g];
+  for (Digit w = 1; w <= 9; w++) {
+    if (w == v) {
+      continue;
+    }
+    bool inSet[81] = {};
+    Index stack[18];
+    int top = 0;
+    stack[top++] = g;
+    inSet[g] = true;
+    bool clear = true;
+    while (top > 0 && clear) {
+      const Index c = stack[--top];
+      const Digit other = (solution[c] == v) ? w : v;
+      const Index *units[3] = {ROW_CELLS[idxRow(c)], COL_CELLS[idxCol(c)], BOX_CELLS[idxBox(c)]};
+      for (const Index *cells : units) {
+        for (int k = 0; k < 9; k++) {
+          const Index p = cells[k];
+          if (solution[p] != other || inSet[p]) {
+            continue;
+          }
+          if (givens[p]) {
+            clear = false;
+            break;
+          }
+          inSet[p] = true;
+          stack[top++] = p;
+        }
+      }
+    }
+    if (clear) {
+      return true;
+    }
+  }
+  return false;
+}
+
+} // namespace
+
+MinimalityCheck::Status MinimalityCheck::run(const Digit givens[81]) {
+  count = 0;
+  numGivens = 0;
+  solutionCount = 0;
+
+  MaskBoard start;
+  if (!start.init(givens)) {
+    return INVALID;
+  }
+  for (int i = 0; i < 81; i++) {
+    numGivens += givens[i] ? 1 : 0;
+  }
+  if (start.propagate()) {
+    solutionCount = start.countSolutions(2, solution);
+  }
+  if (solutionCount != 1) {
+    return NOT_UNIQUE;
+  }
+
+  Digit trial[81];
+  for (int i = 0; i < 81; i++) {
+    trial[i] = givens[i];
+  }
+  for (Index g = 0; g < 81; g++) {
+    if (givens[g] == 0 || hasSwapSolution(solution, givens, g)) {
+      continue;  // empty, or necessary: a swap of two digits solves the puzzle without it
+    }
+    trial[g] = 0;
+    MaskBoard board;
+    board.init(trial);  // a subset of consistent givens: cannot fail
+    trial[g] = givens[g];
+
+    // a second solution has another digit in g; without one, g is redundant
+    board.cands[g] &= (Mask)~digitToBit(givens[g]);
+    if (board.cands[g] != 0 && board.propagate() && board.countSolutions(1, nullptr, solution) > 0) {
+      continue;
+    }
+    cells[count++] = g;
+  }
+  return count ? NOT_MINIMAL : MINIMAL;
+}
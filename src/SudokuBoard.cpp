@@ -1,3 +1,5 @@
+#include <cstring>
+
 #include "SudokuBoard.hpp"
 #include "utils.hpp"
 
@@ -11,41 +13,45 @@ SudokuBoard::SudokuBoard() = default;
 // only values, candidates are calculated automatically
 int SudokuBoard::importFromString(const char *values) {
   // parse: digits 1..9 are values; 0 or '.' are empty; ignore others
+  // cells are filled by token count, so separators between symbols are allowed
   int tokens = 0;
-  for (int i = 0; values[i] != '\0'; i++) {
+  for (int i = 0; values[i] != '\0' && tokens < 81; i++) {
     const char ch = values[i];
     if (ch >= '1' && ch <= '9') {
       // given
-      cells[i].setValue(ch - '0');
+      cells[tokens].setValue(ch - '0');
       ++tokens;
     } else if (ch == '0' || ch == '.') {
       // empty
-      cells[i].setValue(0);
+      cells[tokens].setValue(0);
       ++tokens;
-    } else {
-      // skip character
-      continue;
-    }
-
-    if (tokens == 81) {
-      break;
     }
+    // else skip character
   }
+  version++;
 
   /* Sudoku incompleto se non ho 81 simboli riconosciuti (0-9 o '.') */
   if (tokens < 81) {
     return 0;
   }
 
-  // calculate candidates
-  _recalcAllCandidatesFromValues();
+  // calculate candidates, rejecting conflicting givens
+  if (!recalcAllCandidatesFromValues()) {
+    return 0;
+  }
 
   return 1;
 }
 
 // values and candidates
+// Validation happens once here, so techniques can trust the board afterwards.
 int SudokuBoard::importFromBuffers(const uint8_t *values, const uint16_t *cands) {
-  // TODO: error handling
+  for (int i = 0; i < 81; i++) {
+    if (values[i] > 9) {
+      return 0;
+    }
+  }
+
   for (int i = 0; i < 81; i++) {
     cells[i].setValue(values[i]);
     // If JS provides candidates for solved cells too, keep them consistent anyway.
@@ -55,8 +61,9 @@ int SudokuBoard::importFromBuffers(const uint8_t *values, const uint16_t *cands)
       cells[i].setCandidateMask(digitToBit(values[i]));
     }
   }
+  version++;
   return 1;
- }
+}
 
 void SudokuBoard::exportToBuffers(uint8_t *values, uint16_t *cands) const {
   for (int i = 0; i < 81; i++) {
@@ -65,6 +72,175 @@ void SudokuBoard::exportToBuffers(uint8_t *values, uint16_t *cands) const {
   }
 }
 
+// --- compact binary form ---
+void SudokuBoard::pack(uint8_t *buf) const {
+  for (size_t i = 0; i < PACKED_SIZE; i++) {
+    buf[i] = 0;
+  }
+
+  uint8_t *solved = buf;
+  uint8_t *masks = buf + 11;
+  for (int i = 0; i < 81; i++) {
+    if (cells[i].isSolved()) {
+      solved[i >> 3] |= (uint8_t)(1u << (i & 7));
+    }
+    // a solved cell keeps only its digit as candidate, so the mask also encodes the value
+    const uint32_t bit = (uint32_t)i * 9u;
+    const uint32_t m = (uint32_t)cells[i].getCandidateMask() << (bit & 7u);
+    masks[bit >> 3] |= (uint8_t)(m & 0xFFu);
+    masks[(bit >> 3) + 1] |= (uint8_t)((m >> 8) & 0xFFu);
+  }
+}
+
+int SudokuBoard::unpack(const uint8_t *buf) {
+  const uint8_t *solved = buf;
+  const uint8_t *masks = buf + 11;
+
+  // validate everything before touching the board
+  Mask cands[81];
+  for (int i = 0; i < 81; i++) {
+    const uint32_t bit = (uint32_t)i * 9u;
+    const uint32_t raw = (uint32_t)masks[bit >> 3] | ((uint32_t)masks[(bit >> 3) + 1] << 8);
+    cands[i] = (Mask)((raw >> (bit & 7u)) & 0x1FFu);
+    const bool isSet = (solved[i >> 3] >> (i & 7)) & 1u;
+    if (isSet && countBits9(cands[i]) != 1) {
+      return 0;
+    }
+  }
+  if ((solved[10] & 0xFEu) || (masks[91] & 0xFEu)) {
+    return 0; // padding bits after cell 80 (in its solved flag byte and mask bytes)
+  }
+
+  for (int i = 0; i < 81; i++) {
+    const bool isSet = (solved[i >> 3] >> (i & 7)) & 1u;
+    cells[i].setValue(isSet ? bitToDigitSingle(cands[i]) : 0);
+    cells[i].setCandidateMask(cands[i]);
+  }
+  version++;
+  return 1;
+}
+
+// --- pencilmarks ---
+namespace {
+
+// Fixed layout: the text is compared with "123456789" repeated 81 times, one flat
+// loop of byte compares the compiler vectorizes, and the flags are then gathered
+// 8 cells' worth of bytes at a time into the masks.
+struct PencilmarkSlots {
+  char digit[SudokuBoard::PENCILMARKS_SIZE];
+
+  PencilmarkSlots() {
+    for (size_t n = 0; n < SudokuBoard::PENCILMARKS_SIZE; n++) {
+      digit[n] = (char)('1' + n % 9);
+    }
+  }
+};
+
+bool parseFixedPencilmarks(const char *text, Mask masks[81]) {
+  static const PencilmarkSlots slots;
+  if (strnlen(text, SudokuBoard::PENCILMARKS_SIZE) < SudokuBoard::PENCILMARKS_SIZE) {
+    return false;
+  }
+
+  uint8_t set[SudokuBoard::PENCILMARKS_SIZE + 7];
+  uint8_t bad = 0;
+  for (size_t n = 0; n < SudokuBoard::PENCILMARKS_SIZE; n++) {
+    const char c = text[n];
+    const uint8_t s = c == slots.digit[n];
+    set[n] = s;
+    bad |= (uint8_t)(s | (c == '.') | (c == '0')) ^ 1u;
+  }
+  if (bad) {
+    return false;
+  }
+
+  for (int i = 0; i < 81; i++) {
+    // 8 flag bytes (0 or 1, little-endian) to 8 bits: the multiply moves byte k to bit 56 + k
+    uint64_t low;
+    std::memcpy(&low, set + i * 9, 8);
+    masks[i] = (Mask)(((low * 0x0102040810204080ull) >> 56) | ((unsigned)set[i * 9 + 8] << 8));
+  }
+  return true;
+}
+
+// Printed grid: one run of digits per cell, anything else separates cells.
+bool parseGridPencilmarks(const char *text, Mask masks[81]) {
+  int cell = -1;
+  bool inRun = false;
+  for (const char *p = text; *p != '\0'; p++) {
+    const char c = *p;
+    if (c >= '1' && c <= '9') {
+      if (!inRun) {
+        if (++cell == 81) {
+          return false;
+        }
+        masks[cell] = 0;
+        inRun = true;
+      }
+      masks[cell] |= digitToBit((Digit)(c - '0'));
+    } else {
+      inRun = false;
+    }
+  }
+  return cell == 80;
+}
+
+} // namespace
+
+int SudokuBoard::importFromPencilmarks(const char *text) {
+  Mask masks[81];
+  if (!parseFixedPencilmarks(text, masks) && !parseGridPencilmarks(text, masks)) {
+    return 0;
+  }
+
+  // single candidates are placed values; a unit may hold each of them once
+  Digit values[81];
+  Mask rowUsed[9] = {0};
+  Mask colUsed[9] = {0};
+  Mask boxUsed[9] = {0};
+  for (Index i = 0; i < 81; i++) {
+    values[i] = 0;
+    if (masks[i] == 0) {
+      return 0;
+    }
+    const Mask bit = masks[i];
+    if (bit & (bit - 1)) {
+      continue;
+    }
+    const int r = idxRow(i);
+    const int c = idxCol(i);
+    const int b = idxBox(i);
+    if ((rowUsed[r] | colUsed[c] | boxUsed[b]) & bit) {
+      return 0;
+    }
+    rowUsed[r] |= bit;
+    colUsed[c] |= bit;
+    boxUsed[b] |= bit;
+    values[i] = bitToDigitSingle(bit);
+  }
+
+  for (int i = 0; i < 81; i++) {
+    cells[i].setValue(values[i]);
+    cells[i].setCandidateMask(masks[i]);
+  }
+  version++;
+  return 1;
+}
+
+void SudokuBoard::exportToPencilmarks(char *out) const {
+  for (int i = 0; i < 81; i++) {
+    const Digit v = cells[i].getValue();
+    const Mask m = v ? digitToBit(v) : cells[i].getCandidateMask();
+    // digits 1..8 as one word: each byte keeps its own bit of m and becomes 0x00 or
+    // 0xFF, selecting '1'+k over '.' (bytewise, no carries)
+    uint64_t spread = ((uint64_t)(m & 0xFF) * 0x0101010101010101ull) & 0x8040201008040201ull;
+    spread = (((spread + 0x7F7F7F7F7F7F7F7Full) & 0x8080808080808080ull) >> 7) * 0xFF;
+    const uint64_t word = 0x2E2E2E2E2E2E2E2Eull + (spread & 0x0A09080706050403ull);
+    std::memcpy(out + i * 9, &word, 8);
+    out[i * 9 + 8] = (m >> 8) ? '9' : '.';
+  }
+}
+
 // --- values API ---
 Digit SudokuBoard::getValue(Index idx) const {
   return cells[idx].getValue();
@@ -76,10 +252,12 @@ bool SudokuBoard::isSolved(Index idx) const {
 
 void SudokuBoard::setValue(Index idx, Digit digit) {
   cells[idx].setValue(digit);
+  version++;
 }
 
 void SudokuBoard::clearValue(Index idx) {
   cells[idx].clearValue();
+  version++;
 }
 
 // --- candidates API ---
@@ -89,6 +267,7 @@ Mask SudokuBoard::getCandidateMask(Index idx) const {
 
 void SudokuBoard::setCandidateMask(Index idx, Mask mask) {
   cells[idx].setCandidateMask(mask);
+  version++;
 }
 
 bool SudokuBoard::hasCandidate(Index idx, Digit digit) const {
@@ -104,7 +283,9 @@ Digit SudokuBoard::getSingleCandidate(Index idx) const {
 }
 
 void SudokuBoard::disableCandidate(Index idx, Digit digit) {
-  cells[idx].disableCandidate(digit);
+  if (cells[idx].disableCandidate(digit)) {
+    version++;
+  }
 }
 
 // --- events API ---
@@ -145,6 +326,10 @@ void SudokuBoard::autoClearPeersAfterPlacement(Index idx, Digit digit) {
   }
 }
 
+uint32_t SudokuBoard::getVersion() const {
+  return version;
+}
+
 bool SudokuBoard::isCompletelySolved() const {
   for (const SudokuCell &cell : cells) {
     if (!cell.isSolved()) {
@@ -158,7 +343,7 @@ inline bool SudokuBoard::isValidIndex(Index idx) {
   return idx >= 0 && idx < 81;
 }
 
-bool SudokuBoard::_recalcAllCandidatesFromValues() {
+bool SudokuBoard::recalcAllCandidatesFromValues() {
   // Reset completo
   for (int i = 0; i < 81; i++) {
     setCandidateMask(i, 0);
@@ -3,9 +3,29 @@
 //
 // Exported functions:
 //   int sudorix_solver_full(const char *in81, char *out81);
+//   int sudorix_solver_full_budget(const char *in81, char *out81, const SudorixBudget *budget);
 //   int sudorix_solver_init_board(const char *in81);
 //   int sudorix_solver_next_step(uint32_t *out, uint32_t out_words);
 //   int sudorix_solver_hint(const uint8_t *values, const uint16_t *cands, uint32_t *out, uint32_t out_words);
+//   int sudorix_solver_hint_best(const uint8_t *values, const uint16_t *cands, uint32_t *out, uint32_t out_words,
+//                                uint32_t max_tier, uint32_t lookahead_us);
+//   int sudorix_solver_hint_all(const uint8_t *values, const uint16_t *cands, uint32_t techniques,
+//                               uint32_t *out, uint32_t out_words, uint32_t *available);
+//   int sudorix_solver_export_board(uint8_t *values, uint16_t *cands);
+//   int sudorix_solver_parse_board(const char *in81, uint8_t *values, uint16_t *cands);
+//   int sudorix_solver_parse_pencilmarks(const char *text, uint8_t *values, uint16_t *cands);
+//   int sudorix_solver_format_pencilmarks(const uint8_t *values, const uint16_t *cands, char *out729);
+//   int sudorix_solver_load_board(const uint8_t *values, const uint16_t *cands);
+//   int sudorix_solver_recalc_candidates(const uint8_t *values, uint16_t *cands);
+//   int sudorix_solver_clear_peers(const uint8_t *values, uint16_t *cands, uint32_t idx, uint32_t digit);
+//   int sudorix_solver_check_grid(const uint8_t *values, uint32_t *out, uint32_t out_words);
+//   int sudorix_solver_run_tier(uint8_t *values, uint16_t *cands, uint32_t max_tier);
+//   int sudorix_solver_full_batch(const char *in81s, char *out81s, uint32_t count);
+//   int sudorix_solver_backdoor(const char *in81, uint32_t max_cells, uint32_t budget_us,
+//                               uint32_t *out, uint32_t out_words);
+//   int sudorix_solver_minimality(const char *in81, uint32_t *out, uint32_t out_words);
+//   int sudorix_solver_snapshot(uint8_t *buf, uint32_t buf_size);
+//   int sudorix_solver_restore(const uint8_t *buf, uint32_t size);
 //
 // JS -> WASM contract:
 //   in81[81]   : char      (0 = empty, 1..9 = digit)
@@ -22,36 +42,106 @@
 //   out[3] = count    (number of operations)
 //   out[4..]          (operations as 'count' pairs of cell and value)
 //
-// State is managed by the caller for sudorix_solver_hint.
+// State is managed by the caller for sudorix_solver_hint, sudorix_solver_hint_best and
+// sudorix_solver_hint_all.
 // State is managed by WASM for sudorix_solver_full and sudorix_solver_next_step.
-// sudorix_solver_next_step requires an initial call to sudorix_solver_init_board.
+// sudorix_solver_export_board copies the state managed by WASM back into values[81]/cands[81].
+// sudorix_solver_next_step requires an initial call to sudorix_solver_init_board or
+// sudorix_solver_load_board.
+// sudorix_solver_recalc_candidates, sudorix_solver_clear_peers and sudorix_solver_check_grid are
+// the board-editing helpers of the UI: they work in place on caller-owned values/cands, which
+// JS keeps in WASM memory as the board it displays.
+// sudorix_solver_snapshot/sudorix_solver_restore save and reload the state managed by WASM
+// (board, pending events and the technique scan left half-way), so a step-by-step session
+// can be resumed in another process.
+// sudorix_solver_run_tier works in place on caller-owned values/cands, so a stalled board can be
+// resumed later with a higher tier (see SudorixTier).
+// sudorix_solver_full_budget returns SUDORIX_BUDGET_EXHAUSTED or SUDORIX_CANCELLED (with the
+// partial board in out81) when its budget runs out or its cancel flag is raised.
 //
 // Notes:
 //   - The event queue is stored in WASM as persistent state (g_eventQueue contains unique events).
+//   - Native builds keep one solver context (board + queue) per thread, so different threads
+//     can drive the API concurrently; WASM is single-threaded and sees a plain global.
 //   - JS must provide a consistent board (values and candidates) before calling sudorix_solver_hint.
 //   - JS must initialize the board with sudorix_solver_init_board before using sudorix_solver_next_step.
 //   - JS does not need to manage the state when using sudorix_solver_full and sudorix_solver_next_step other than UI purpose.
 
+#include <chrono>
 #include <cstdint>
 #include <cstddef>
 #include <cstring>
 #include <functional>
-#include <set>
+#include <utility>
 #include <vector>
 
 #include "solver.hpp"
 #include "SudokuBoard.hpp"
 #include "EventQueue.hpp"
+#include "BoardAnalysis.hpp"
+#include "BoardBatch.hpp"
+#include "Backdoor.hpp"
+#include "Minimality.hpp"
+#include "techniques.hpp"
 #include "utils.hpp"
 
-static SudokuBoard g_sudokuBoard;
-static EventQueue g_eventQueue;
+static thread_local SudokuBoard g_sudokuBoard;
+static thread_local EventQueue g_eventQueue;
+// empty outside sudorix_technique_run, which swaps it in for g_eventQueue
+static thread_local EventQueue g_scratchQueue;
+
+// first byte of sudorix_solver_snapshot blobs, bump on layout changes
+static constexpr uint8_t SNAPSHOT_VERSION = 2;
+
+// optional observer of technique passes (tracing), disabled when null
+static thread_local TechniquePassHook g_passHook = nullptr;
+static thread_local void *g_passHookCtx = nullptr;
+
+// Technique whose scan stopped at its first finding, and where it resumes on the next step.
+struct ResumeState {
+  size_t technique;
+  uint32_t cursor;
+};
+static constexpr size_t NO_RESUME = SIZE_MAX;
+static thread_local ResumeState g_resume = { NO_RESUME, 0 };
+
+// Highest technique tier the pipeline may use (SUDORIX_TIER_ALL = no limit).
+static thread_local uint32_t g_maxTier = SUDORIX_TIER_ALL;
+
+// Budget of the running sudorix_solver_full_budget call, null when unlimited.
+struct BudgetState {
+  const SudorixBudget *limits;
+  uint32_t steps;
+  uint32_t evals;
+  std::chrono::steady_clock::time_point deadline;
+  int status;  // SUDORIX_OK while within budget
+};
+static thread_local BudgetState *g_budget = nullptr;
+
+// Sets found by sudorix_solver_backdoor, direct-mapped on a hash of the givens.
+// A smallest set depends only on the puzzle, so a hit is valid for any later limits.
+struct BackdoorCacheEntry {
+  bool used;
+  Digit givens[81];
+  uint8_t count;
+  Index cells[81];
+  Digit digits[81];
+};
+static constexpr size_t BACKDOOR_CACHE_SIZE = 64;
+static thread_local BackdoorCacheEntry g_backdoorCache[BACKDOOR_CACHE_SIZE];
 
 // =========================================================
 // Techniques
 // =========================================================
-
-static void techFullHouse(SudokuBoard &board) {
+//
+// Every technique is a resumable scan over a fixed sequence of positions (units,
+// unit x digit pairs, cells). It starts at 'from', stops right after the first
+// position that enqueues something and returns where the next call has to resume,
+// or TECHNIQUE_SCAN_DONE once the end is reached. The step API consumes one event
+// per call, so findings past the first are only computed when they are asked for
+// (and against the board as it is then, instead of going stale in the queue).
+
+static uint32_t techFullHouse(SudokuBoard &board, BoardAnalysis &, uint32_t from) {
   auto scanUnit = [&](const Index unitCells[9]) -> void
   {
     Index emptyIdx = -1;
@@ -83,244 +173,151 @@ static void techFullHouse(SudokuBoard &board) {
     }
   };
 
-  for (int u = 0; u < 9; u++) {
-    scanUnit(BOX_CELLS[u]);
-    scanUnit(ROW_CELLS[u]);
-    scanUnit(COL_CELLS[u]);
+  // positions: box, row, column of unit 0, then of unit 1, ...
+  for (uint32_t p = from; p < 27; p++) {
+    const size_t before = g_eventQueue.size();
+    scanUnit(BoardAnalysis::unitCells((int)((p % 3) * 9 + p / 3)));
+    if (g_eventQueue.size() != before) {
+      return p + 1;
+    }
   }
+  return TECHNIQUE_SCAN_DONE;
 }
 
-static void techHiddenSingles(SudokuBoard &board) {
-  auto scanUnit = [&](const Index unitCells[9]) -> void
-  {
-    for (Digit digit = 1; digit <= 9; digit++) {
-      Index foundIdx = -1;
-      for (int k = 0; k < 9; k++) {
-        const Index idx = unitCells[k];
-        if (board.isSolved(idx)) {
-          continue;
-        }
-        if (board.hasCandidate(idx, digit)) {
-          if (foundIdx != -1) {
-            foundIdx = -2; // multiple places
-            break;
-          }
-          foundIdx = idx;
-        }
-      }
-      if (foundIdx >= 0) {
-        Event event(EventType::SetValue, ReasonId::HiddenSingle);
-        event.addOperation(foundIdx, digit);
-        g_eventQueue.enqueue(board, event);
-      }
+static uint32_t techHiddenSingles(SudokuBoard &board, BoardAnalysis &analysis, uint32_t from) {
+  // positions: every digit of every box, then rows, then columns
+  for (uint32_t p = from; p < 27 * 9; p++) {
+    const int unit = (int)(p / 9);
+    const Digit digit = (Digit)(p % 9 + 1);
+    const Mask where = analysis.positions(unit, digit);
+    if (countBits9(where) != 1) {
+      continue;
+    }
+    const size_t before = g_eventQueue.size();
+    Event event(EventType::SetValue, ReasonId::HiddenSingle);
+    event.addOperation(BoardAnalysis::unitCells(unit)[lowestBitIndex(where)], digit);
+    g_eventQueue.enqueue(board, event);
+    if (g_eventQueue.size() != before) {
+      return p + 1;
     }
-  };
-
-  for (int u = 0; u < 9; u++) {
-    scanUnit(BOX_CELLS[u]);
-  }
-  for (int u = 0; u < 9; u++) {
-    scanUnit(ROW_CELLS[u]);
   }
-  for (int u = 0; u < 9; u++) {
-    scanUnit(COL_CELLS[u]);
+  return TECHNIQUE_SCAN_DONE;
+}
+
+// Enqueues the removal of 'digit' from the cells of 'unitCells' selected by 'where'.
+static void enqueueRemovals(SudokuBoard &board, ReasonId reasonId, const Index *unitCells, Mask where,
+                            Digit digit) {
+  Event event(EventType::RemoveCandidate, reasonId);
+  while (where) {
+    event.addOperation(unitCells[lowestBitIndex(where)], digit);
+    where &= (Mask)(where - 1);
   }
+  g_eventQueue.enqueue(board, event);
 }
 
-static void techLockedCandidates(SudokuBoard &board) {
+static uint32_t techLockedCandidates(SudokuBoard &board, BoardAnalysis &analysis, uint32_t from) {
   // For each box and digit:
   //  - if all candidates are confined to a single row within the box,
   //    remove the digit from that row outside the box
   //  - same for a single column
-  for (int b = 0; b < 9; b++) {
-    for (Digit digit = 1; digit <= 9; digit++) {
-      std::vector<Index> positions;
-      for (int k = 0; k < 9; k++) {
-        const Index idx = BOX_CELLS[b][k];
-        if (board.isSolved(idx)) {
-          continue;
-        }
-        if (board.hasCandidate(idx, digit)) {
-          positions.push_back(idx);
-        }
-      }
-
-      size_t posCount = positions.size();
-      if (posCount < 2) {
-        continue; // locked candidates is about confinement with at least 2
-      }
-
-      ReasonId reasonId;
-      if (posCount == 2) {
-        reasonId = ReasonId::PointingPair;
-      } else if (posCount == 3) {
-        reasonId = ReasonId::PointingTriple;
-      } else {
-        // generic name
-        reasonId = ReasonId::LockedCandidates;
-      }
+  for (uint32_t p = from; p < 9 * 9; p++) {
+    const int b = (int)(p / 9);
+    const Digit digit = (Digit)(p % 9 + 1);
+
+    // box positions: k = 3 * (row in box) + (column in box)
+    const Mask inBox = analysis.positions(b, digit);
+    const int posCount = countBits9(inBox);
+    if (posCount < 2) {
+      continue; // locked candidates is about confinement with at least 2
+    }
 
-      const int r0 = idxRow(positions[0]);
-      bool sameRow = true;
-      for (Index pos : positions) {
-        if (idxRow(pos) != r0) {
-          sameRow = false;
-          break;
-        }
-      }
+    ReasonId reasonId;
+    if (posCount == 2) {
+      reasonId = ReasonId::PointingPair;
+    } else if (posCount == 3) {
+      reasonId = ReasonId::PointingTriple;
+    } else {
+      // generic name
+      reasonId = ReasonId::LockedCandidates;
+    }
 
-      if (sameRow) {
-        // remove digit from row r0, excluding cells in this box
-        Event event(EventType::RemoveCandidate, reasonId);
-        for (int k = 0; k < 9; k++) {
-          const Index idx = ROW_CELLS[r0][k];
-          if (idxBox(idx) == b) {
-            continue;
-          }
-          if (!board.isSolved(idx) && board.hasCandidate(idx, digit)) {
-            event.addOperation(idx, digit);
-          }
-        }
-        g_eventQueue.enqueue(board, event);
-      }
+    const size_t before = g_eventQueue.size();
+    const int k0 = lowestBitIndex(inBox);
+    const Index first = BOX_CELLS[b][k0];
+
+    if ((inBox & ~(Mask)(0x7u << (3 * (k0 / 3)))) == 0) {
+      // remove digit from the row, excluding cells in this box (row positions are columns)
+      const int r0 = idxRow(first);
+      const Mask outside = (Mask)(analysis.positions(9 + r0, digit) & ~(0x7u << (3 * (b % 3))));
+      enqueueRemovals(board, reasonId, ROW_CELLS[r0], outside, digit);
+    }
 
-      const int c0 = idxCol(positions[0]);
-      bool sameCol = true;
-      for (Index pos : positions) {
-        if (idxCol(pos) != c0) {
-          sameCol = false;
-          break;
-        }
-      }
+    if ((inBox & ~(Mask)(0x49u << (k0 % 3))) == 0) {
+      // remove digit from the column, excluding cells in this box (column positions are rows)
+      const int c0 = idxCol(first);
+      const Mask outside = (Mask)(analysis.positions(18 + c0, digit) & ~(0x7u << (3 * (b / 3))));
+      enqueueRemovals(board, reasonId, COL_CELLS[c0], outside, digit);
+    }
 
-      if (sameCol) {
-        // remove digit from column c0, excluding cells in this box
-        Event event(EventType::RemoveCandidate, reasonId);
-        for (int k = 0; k < 9; k++) {
-          const Index idx = COL_CELLS[c0][k];
-          if (idxBox(idx) == b) {
-            continue;
-          }
-          if (!board.isSolved(idx) && board.hasCandidate(idx, digit)) {
-            event.addOperation(idx, digit);
-          }
-        }
-        g_eventQueue.enqueue(board, event);
-      }
+    if (g_eventQueue.size() != before) {
+      return p + 1;
     }
   }
+  return TECHNIQUE_SCAN_DONE;
 }
 
-static void techBoxLineReduction(SudokuBoard &board) {
-  // rows
-  for (int r = 0; r < 9; r++) {
-    for (Digit digit = 1; digit <= 9; digit++) {
-      std::vector<Digit> positions;
-      for (int k = 0; k < 9; k++) {
-        const Index idx = ROW_CELLS[r][k];
-        if (board.isSolved(idx)) {
-          continue;
-        }
-        if (board.hasCandidate(idx, digit)) {
-          positions.push_back(idx);
-        }
-      }
-
-      size_t posCount = positions.size();
-      if (posCount < 2 || posCount > 3) {
-        continue; // box line reduction is about confinement with 2 or 3
-      }
-
-      ReasonId reasonId = ReasonId::BoxLineReduction;
-
-      std::set<int> boxes;
-      bool sameBlock = true;
-      for (Index pos : positions) {
-        boxes.insert(idxBox(pos));
-      }
-
-      if (boxes.size() == 1) {
-        // remove digit from this box, excluding cells in this row/column
-        int boxIdx = *boxes.begin();
-
-        Event event(EventType::RemoveCandidate, reasonId);
-        for (int k = 0; k < 9; k++) {
-          const Index idx = BOX_CELLS[boxIdx][k];
-          if (idxRow(idx) == r) {
-            continue;
-          }
-          if (!board.isSolved(idx) && board.hasCandidate(idx, digit)) {
-            event.addOperation(idx, digit);
-          }
-        }
-        g_eventQueue.enqueue(board, event);
-      }
+static uint32_t techBoxLineReduction(SudokuBoard &board, BoardAnalysis &analysis, uint32_t from) {
+  // positions: every digit of every row, then of every column
+  for (uint32_t p = from; p < 2 * 9 * 9; p++) {
+    const bool byRow = p < 9 * 9;
+    const int line = (int)((p % 81) / 9);
+    const Digit digit = (Digit)(p % 9 + 1);
+
+    const Mask inLine = analysis.positions(byRow ? 9 + line : 18 + line, digit);
+    const int posCount = countBits9(inLine);
+    if (posCount < 2 || posCount > 3) {
+      continue; // box line reduction is about confinement with 2 or 3
     }
-  }
-
-  // columns
-  for (int c = 0; c < 9; c++) {
-    for (Digit digit = 1; digit <= 9; digit++) {
-      std::vector<Digit> positions;
-      for (int k = 0; k < 9; k++) {
-        const Index idx = COL_CELLS[c][k];
-        if (board.isSolved(idx)) {
-          continue;
-        }
-        if (board.hasCandidate(idx, digit)) {
-          positions.push_back(idx);
-        }
-      }
-
-      size_t posCount = positions.size();
-      if (posCount < 2 || posCount > 3) {
-        continue; // box line reduction is about confinement with 2 or 3
-      }
 
-      ReasonId reasonId = ReasonId::BoxLineReduction;
-
-      std::set<Index> boxes;
-      bool sameBlock = true;
-      for (Index pos : positions) {
-        boxes.insert(idxBox(pos));
-      }
+    // line positions 3s..3s+2 lie in the same box
+    const int segment = lowestBitIndex(inLine) / 3;
+    if ((inLine & ~(Mask)(0x7u << (3 * segment))) != 0) {
+      continue;
+    }
 
-      if (boxes.size() == 1) {
-        // remove digit from this box, excluding cells in this row/column
-        Index boxIdx = *boxes.begin();
+    // remove digit from this box, excluding cells in this row/column
+    const int boxIdx = byRow ? (line / 3) * 3 + segment : segment * 3 + line / 3;
+    const Mask lineInBox = byRow ? (Mask)(0x7u << (3 * (line % 3))) : (Mask)(0x49u << (line % 3));
+    const Mask outside = (Mask)(analysis.positions(boxIdx, digit) & ~lineInBox);
 
-        Event event(EventType::RemoveCandidate, reasonId);
-        for (int k = 0; k < 9; k++) {
-          const Index idx = BOX_CELLS[boxIdx][k];
-          if (idxCol(idx) == c) {
-            continue;
-          }
-          if (!board.isSolved(idx) && board.hasCandidate(idx, digit)) {
-            event.addOperation(idx, digit);
-          }
-        }
-        g_eventQueue.enqueue(board, event);
-      }
+    const size_t before = g_eventQueue.size();
+    enqueueRemovals(board, ReasonId::BoxLineReduction, BOX_CELLS[boxIdx], outside, digit);
+    if (g_eventQueue.size() != before) {
+      return p + 1;
     }
   }
+  return TECHNIQUE_SCAN_DONE;
 }
 
-static void techNakedSingles(SudokuBoard &board) {
-  for (int i = 0; i < 81; i++) {
-    if (board.isSolved(i)) {
+static uint32_t techNakedSingles(SudokuBoard &board, BoardAnalysis &analysis, uint32_t from) {
+  for (uint32_t i = from; i < 81; i++) {
+    if (analysis.candidateCount(i) != 1) {
       continue;
     }
     const Digit d = board.getSingleCandidate(i);
     if (d != 0) {
       Event event(EventType::SetValue, ReasonId::NakedSingle);
       event.addOperation(i, d);
+      const size_t before = g_eventQueue.size();
       g_eventQueue.enqueue(board, event);
+      if (g_eventQueue.size() != before) {
+        return i + 1;
+      }
     }
   }
+  return TECHNIQUE_SCAN_DONE;
 }
 
-typedef void (*TechniqueFn)(SudokuBoard &);
-
 static constexpr TechniqueFn TECHNIQUES[] =
 {
   techFullHouse,
@@ -330,6 +327,68 @@ static constexpr TechniqueFn TECHNIQUES[] =
   techBoxLineReduction
 };
 
+// keep aligned with TECHNIQUES
+static constexpr const char *TECHNIQUE_NAMES[] =
+{
+  "techFullHouse",
+  "techHiddenSingles",
+  "techLockedCandidates",
+  "techNakedSingles",
+  "techBoxLineReduction"
+};
+
+// keep aligned with TECHNIQUES (SudorixTier: lowest tier that enables the technique)
+static constexpr uint32_t TECHNIQUE_TIERS[] =
+{
+  SUDORIX_TIER_SINGLES,
+  SUDORIX_TIER_SINGLES,
+  SUDORIX_TIER_INTERSECTIONS,
+  SUDORIX_TIER_SINGLES,
+  SUDORIX_TIER_INTERSECTIONS
+};
+
+static constexpr size_t NUM_TECHNIQUES = sizeof(TECHNIQUES) / sizeof(TECHNIQUES[0]);
+static_assert((1u << (NUM_TECHNIQUES - 1)) == SUDORIX_TECH_BOX_LINE_REDUCTION,
+              "SudorixTechnique (solver.hpp) must have one bit per technique, in TECHNIQUES order");
+static_assert(sizeof(TECHNIQUE_NAMES) / sizeof(TECHNIQUE_NAMES[0]) == NUM_TECHNIQUES,
+              "TECHNIQUE_NAMES must list every technique");
+static_assert(sizeof(TECHNIQUE_TIERS) / sizeof(TECHNIQUE_TIERS[0]) == NUM_TECHNIQUES,
+              "TECHNIQUE_TIERS must list every technique");
+
+size_t sudorix_technique_count() {
+  return NUM_TECHNIQUES;
+}
+
+const char *sudorix_technique_name(size_t i) {
+  return (i < NUM_TECHNIQUES) ? TECHNIQUE_NAMES[i] : nullptr;
+}
+
+void sudorix_set_technique_pass_hook(TechniquePassHook hook, void *ctx) {
+  g_passHook = hook;
+  g_passHookCtx = ctx;
+}
+
+uint32_t sudorix_technique_tier(size_t i) {
+  return (i < NUM_TECHNIQUES) ? TECHNIQUE_TIERS[i] : 0;
+}
+
+size_t sudorix_technique_run(size_t i, SudokuBoard &board, BoardAnalysis &analysis) {
+  if (i >= NUM_TECHNIQUES) {
+    return 0;
+  }
+  // techniques enqueue on g_eventQueue: park the session queue (and so keep g_resume
+  // valid) while the scan fills the scratch one, swapping only moves pointers
+  std::swap(g_eventQueue, g_scratchQueue);
+  for (uint32_t p = 0; p != TECHNIQUE_SCAN_DONE; p = TECHNIQUES[i](board, analysis, p)) {
+  }
+  const size_t produced = g_eventQueue.size();
+  Event event;
+  while (g_eventQueue.dequeue(event)) {
+  }
+  std::swap(g_eventQueue, g_scratchQueue);
+  return produced;
+}
+
 static bool is_operation_applicable(SudokuBoard &board, EventType type, Index idx, Digit digit) {
   // you can set only an unsolved cell
   if (type == EventType::SetValue) {
@@ -414,6 +473,58 @@ static int drain_event(SudokuBoard &board,
   return (count > 0) ? 1 : drain_event(board, out, out_words, fromPrev, apply_to_board);
 }
 
+// Cooperative budget check, run between technique passes.
+// Records why the call has to stop in g_budget->status.
+// The step limit is not checked here: it only stops a solve that still has a step to
+// apply, which sudorix_solver_full_budget knows once the next event is computed.
+static bool budget_exhausted() {
+  BudgetState *budget = g_budget;
+  if (budget == nullptr) {
+    return false;
+  }
+  if (budget->status != SUDORIX_OK) {
+    return true;
+  }
+
+  const SudorixBudget *limits = budget->limits;
+  if (limits->cancel && __atomic_load_n(limits->cancel, __ATOMIC_RELAXED) != 0) {
+    budget->status = SUDORIX_CANCELLED;
+  } else if (limits->max_technique_evals && budget->evals >= limits->max_technique_evals) {
+    budget->status = SUDORIX_BUDGET_EXHAUSTED;
+  } else if (limits->deadline_ns && std::chrono::steady_clock::now() >= budget->deadline) {
+    budget->status = SUDORIX_BUDGET_EXHAUSTED;
+  }
+  return budget->status != SUDORIX_OK;
+}
+
+// Runs one technique scan from 'from', with budget accounting and the pass hook.
+// Returns the resume position (see TechniqueFn).
+static uint32_t run_technique(size_t i, SudokuBoard &board, BoardAnalysis &analysis, uint32_t from) {
+  if (g_budget) {
+    g_budget->evals++;
+  }
+  if (!g_passHook) {
+    return TECHNIQUES[i](board, analysis, from);
+  }
+  const size_t before = g_eventQueue.size();
+  const auto t0 = std::chrono::steady_clock::now();
+  const uint32_t next = TECHNIQUES[i](board, analysis, from);
+  const auto t1 = std::chrono::steady_clock::now();
+  g_passHook(g_passHookCtx, i, g_eventQueue.size() - before,
+             (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count());
+  return next;
+}
+
+static bool technique_allowed(size_t i) {
+  return g_maxTier == SUDORIX_TIER_ALL || TECHNIQUE_TIERS[i] <= g_maxTier;
+}
+
+// Forgets any technique scan left half-way (the board changed under it).
+static void reset_resume() {
+  g_resume.technique = NO_RESUME;
+  g_resume.cursor = 0;
+}
+
 // Run techniques to fill the queue if needed, then return a single event.
 // If apply_to_board is true, the drained operations are also applied to 'board'.
 static int compute_next_event(SudokuBoard &board,
@@ -425,16 +536,46 @@ static int compute_next_event(SudokuBoard &board,
     return 1;
   }
 
-  // 2) run techniques in priority order; stop at the first technique that enqueues anything.
-  for (size_t i = 0; i < (sizeof(TECHNIQUES) / sizeof(TECHNIQUES[0])); i++) {
+  // shared by every technique of this call, rebuilt only if the board changes in between
+  BoardAnalysis analysis(board);
+
+  // 2) resume the technique that found the previous event, on the board as it is now;
+  //    its further findings belong to the same round as the first one.
+  while (g_resume.technique != NO_RESUME) {
+    const size_t i = g_resume.technique;
+    if (!technique_allowed(i) || (g_budget && budget_exhausted())) {
+      reset_resume();
+      break;
+    }
+    g_resume.cursor = run_technique(i, board, analysis, g_resume.cursor);
+    if (g_resume.cursor == TECHNIQUE_SCAN_DONE) {
+      reset_resume();
+    }
+    if (drain_event(board, out, out_words, 1u, apply_to_board)) {
+      return 1;
+    }
+  }
+
+  // 3) run techniques in priority order; stop at the first finding.
+  for (size_t i = 0; i < NUM_TECHNIQUES; i++) {
+    if (!technique_allowed(i)) {
+      continue;
+    }
+    if (g_budget && budget_exhausted()) {
+      break; // nothing new is enqueued, the caller reads the status
+    }
     const size_t before = g_eventQueue.size();
-    TECHNIQUES[i](board);
+    const uint32_t next = run_technique(i, board, analysis, 0);
     if (g_eventQueue.size() != before) {
+      if (next != TECHNIQUE_SCAN_DONE) {
+        g_resume.technique = i;
+        g_resume.cursor = next;
+      }
       break;
     }
   }
 
-  // 3) if something has been generated, drain as "fromPrev=0".
+  // 4) if something has been generated, drain as "fromPrev=0".
   if (drain_event(board, out, out_words, 0u, apply_to_board)) {
     return 1;
   }
@@ -449,6 +590,124 @@ static int compute_next_event(SudokuBoard &board,
   return 0;
 }
 
+// Resets the queue and applies events to 'board' until no technique (within g_maxTier) applies.
+static void run_until_stuck(SudokuBoard &board) {
+  g_eventQueue = EventQueue();
+  reset_resume();
+
+  uint32_t tmp[1024];
+  int guard = 0;
+  const int guardMax = 200000;
+  while (guard++ < guardMax) {
+    if (!compute_next_event(board, tmp, 1024, true)) {
+      break;
+    }
+  }
+}
+
+// True if values/cands hold a contradiction: an empty cell without candidates, a digit placed
+// twice in a unit or left without a place in a unit. Until one appears, every technique only
+// removes candidates that no solution needs, so any order of deductions ends on the same board.
+static bool board_contradicted(const Digit *values, const Mask *cands) {
+  for (int i = 0; i < 81; i++) {
+    if (values[i] == 0 && cands[i] == 0) {
+      return true;
+    }
+  }
+  for (int unit = 0; unit < BoardAnalysis::NUM_UNITS; unit++) {
+    const Index *cells = BoardAnalysis::unitCells(unit);
+    Mask seen = 0;
+    Mask anywhere = 0;
+    for (int k = 0; k < 9; k++) {
+      const Digit v = values[cells[k]];
+      if (v != 0 && (seen & digitToBit(v))) {
+        return true;
+      }
+      seen |= v ? digitToBit(v) : 0;
+      anywhere |= v ? digitToBit(v) : cands[cells[k]];
+    }
+    if (anywhere != 0x1FFu) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// A deduction found while ranking hints, with what is known about how easy it is.
+struct HintCandidate {
+  Event event;
+  size_t technique;    // index in TECHNIQUES
+  uint32_t followUp;   // placements forced by singles once it is applied
+};
+
+// Applies 'event' to a copy of 'board' and counts the placements that singles (naked and
+// hidden) force afterwards, the event's own ones excluded. Stops early at 'deadline'.
+static uint32_t lookahead_placements(const SudokuBoard &board,
+                                     Event &event,
+                                     std::chrono::steady_clock::time_point deadline) {
+  SudokuBoard work = board;
+  for (const Operation &op : event.getOperations()) {
+    if (!is_operation_applicable(work, event.type, op.idx, op.digit)) {
+      continue;
+    }
+    if (event.type == EventType::SetValue) {
+      work.applySetValue(op.idx, op.digit);
+    } else {
+      work.applyRemoveCandidate(op.idx, op.digit);
+    }
+  }
+
+  uint32_t placed = 0;
+  BoardAnalysis analysis(work);
+  Index cells[81];
+  Digit digits[81];
+  while (std::chrono::steady_clock::now() < deadline) {
+    // collect the singles of this round on a stable analysis, then apply those still valid
+    int n = 0;
+    for (int i = 0; i < 81; i++) {
+      if (analysis.candidateCount(i) == 1) {
+        cells[n] = (Index)i;
+        digits[n] = work.getSingleCandidate(i);
+        n++;
+      }
+    }
+    for (int unit = 0; unit < BoardAnalysis::NUM_UNITS && n < 81; unit++) {
+      for (Digit d = 1; d <= 9 && n < 81; d++) {
+        const Mask where = analysis.positions(unit, d);
+        if (countBits9(where) == 1) {
+          cells[n] = BoardAnalysis::unitCells(unit)[lowestBitIndex(where)];
+          digits[n] = d;
+          n++;
+        }
+      }
+    }
+
+    uint32_t before = placed;
+    for (int k = 0; k < n; k++) {
+      if (!work.isSolved(cells[k]) && work.hasCandidate(cells[k], digits[k])) {
+        work.applySetValue(cells[k], digits[k]);
+        placed++;
+      }
+    }
+    if (placed == before) {
+      break;
+    }
+  }
+  return placed;
+}
+
+// Ranking of hints: lower tier first, then more follow-up placements, then technique
+// priority, then scan order (the caller keeps candidates in scan order).
+static bool hint_better(const HintCandidate &a, const HintCandidate &b) {
+  if (TECHNIQUE_TIERS[a.technique] != TECHNIQUE_TIERS[b.technique]) {
+    return TECHNIQUE_TIERS[a.technique] < TECHNIQUE_TIERS[b.technique];
+  }
+  if (a.followUp != b.followUp) {
+    return a.followUp > b.followUp;
+  }
+  return a.technique < b.technique;
+}
+
 //
 // FOR DEBUGGING compile with -DDEBUG and use this function:
 // debug_log("Queue has %d elements", g_eventQueue.size());
@@ -464,6 +723,15 @@ extern "C"
   // Returns 0 in case of error, else 1.
   EMSCRIPTEN_KEEPALIVE
   int sudorix_solver_full(const char *in81, char *out81) {
+    return sudorix_solver_full_budget(in81, out81, nullptr);
+  }
+
+  // Same as sudorix_solver_full, within the limits of 'budget' (null = unlimited).
+  // Returns 0 in case of error, 1 when the solver ran to completion (solved or stuck),
+  // SUDORIX_BUDGET_EXHAUSTED or SUDORIX_CANCELLED when it was stopped early.
+  // out81 always receives the board reached so far.
+  EMSCRIPTEN_KEEPALIVE
+  int sudorix_solver_full_budget(const char *in81, char *out81, const SudorixBudget *budget) {
     if (in81 == nullptr || out81 == nullptr) {
       return 0;
     }
@@ -476,6 +744,17 @@ extern "C"
 
     // Reset queue
     g_eventQueue = EventQueue();
+    reset_resume();
+
+    BudgetState state;
+    if (budget) {
+      state.limits = budget;
+      state.steps = 0;
+      state.evals = 0;
+      state.deadline = std::chrono::steady_clock::now() + std::chrono::nanoseconds(budget->deadline_ns);
+      state.status = SUDORIX_OK;
+      g_budget = &state;
+    }
 
     // Solve loop using existing stepper:
     // repeatedly compute one event, apply it locally, and continue until stuck.
@@ -484,10 +763,29 @@ extern "C"
     const int guardMax = 200000;
 
     while (guard++ < guardMax) {
-      const int ok = compute_next_event(board, tmp, 1024, true);
+      if (budget && budget_exhausted()) {
+        break;
+      }
+      // with every step spent, only look for one more: a stall or a solve right at the
+      // limit is a completed run, not an early stop
+      const bool stepsSpent = budget && budget->max_steps && state.steps >= budget->max_steps;
+      const int ok = compute_next_event(board, tmp, 1024, !stepsSpent);
       if (!ok) {
         break;
       }
+      if (stepsSpent) {
+        state.status = SUDORIX_BUDGET_EXHAUSTED;
+        break;
+      }
+      if (budget) {
+        state.steps++;
+      }
+    }
+    g_budget = nullptr;
+
+    // a budget that runs out once the board is solved is not an early stop
+    if (budget && board.isCompletelySolved()) {
+      state.status = SUDORIX_OK;
     }
 
     // Export
@@ -497,7 +795,7 @@ extern "C"
     }
     out81[81] = '\0';
 
-    return 1;
+    return budget ? state.status : 1;
   }
 
   // Initializes the board for a step-by-step solution.
@@ -515,6 +813,7 @@ extern "C"
 
     // Reset queue
     g_eventQueue = EventQueue();
+    reset_resume();
 
     return 1;
   }
@@ -532,6 +831,508 @@ extern "C"
     return ok ? 1 : 0;
   }
 
+  // Parses a Sudoku string into values[81] and the candidates implied by them (cands[81]).
+  // Returns 0 in case of error (malformed or conflicting givens), else 1.
+  EMSCRIPTEN_KEEPALIVE
+  int sudorix_solver_parse_board(const char *in81, uint8_t *values, uint16_t *cands) {
+    if (in81 == nullptr || values == nullptr || cands == nullptr) {
+      return 0;
+    }
+
+    SudokuBoard board;
+    if (!board.importFromString(in81)) {
+      return 0;
+    }
+
+    board.exportToBuffers(values, cands);
+    return 1;
+  }
+
+  // Parses a pencilmark grid (729-character fixed layout or a printed candidate grid,
+  // see SudokuBoard::importFromPencilmarks) into values[81] and cands[81].
+  // Returns 0 in case of error (malformed text, empty cell or conflicting values), else 1.
+  EMSCRIPTEN_KEEPALIVE
+  int sudorix_solver_parse_pencilmarks(const char *text, uint8_t *values, uint16_t *cands) {
+    if (text == nullptr || values == nullptr || cands == nullptr) {
+      return 0;
+    }
+
+    SudokuBoard board;
+    if (!board.importFromPencilmarks(text)) {
+      return 0;
+    }
+
+    board.exportToBuffers(values, cands);
+    return 1;
+  }
+
+  // Writes values/cands as 729 characters in the fixed pencilmark layout (no terminator).
+  // Returns 0 in case of error, else 1.
+  EMSCRIPTEN_KEEPALIVE
+  int sudorix_solver_format_pencilmarks(const uint8_t *values, const uint16_t *cands, char *out729) {
+    if (values == nullptr || cands == nullptr || out729 == nullptr) {
+      return 0;
+    }
+
+    SudokuBoard board;
+    if (!board.importFromBuffers(values, cands)) {
+      return 0;
+    }
+
+    board.exportToPencilmarks(out729);
+    return 1;
+  }
+
+  // Loads the board given in values/cands for a step-by-step solution, like
+  // sudorix_solver_init_board but keeping the caller's candidates (e.g. a board edited in JS).
+  // Returns 0 in case of error, else 1.
+  EMSCRIPTEN_KEEPALIVE
+  int sudorix_solver_load_board(const uint8_t *values, const uint16_t *cands) {
+    if (values == nullptr || cands == nullptr) {
+      return 0;
+    }
+
+    if (!g_sudokuBoard.importFromBuffers(values, cands)) {
+      return 0;
+    }
+
+    g_eventQueue = EventQueue();
+    reset_resume();
+
+    return 1;
+  }
+
+  // Rebuilds cands[81] from values[81] in place; a solved cell keeps only its digit.
+  // Unlike the solver import, conflicting values are accepted: an empty cell whose digits
+  // are all taken ends up with no candidate, so a board being edited can always be shown.
+  // Returns 0 in case of error (value out of range), else 1.
+  EMSCRIPTEN_KEEPALIVE
+  int sudorix_solver_recalc_candidates(const uint8_t *values, uint16_t *cands) {
+    if (values == nullptr || cands == nullptr) {
+      return 0;
+    }
+
+    Mask used[BoardAnalysis::NUM_UNITS] = { 0 };
+    for (Index i = 0; i < 81; i++) {
+      const Digit v = values[i];
+      if (v > 9) {
+        return 0;
+      }
+      if (v) {
+        const Mask bit = digitToBit(v);
+        used[idxBox(i)] |= bit;
+        used[9 + idxRow(i)] |= bit;
+        used[18 + idxCol(i)] |= bit;
+      }
+    }
+
+    for (Index i = 0; i < 81; i++) {
+      const Digit v = values[i];
+      if (v) {
+        cands[i] = digitToBit(v);
+      } else {
+        cands[i] = (uint16_t)(0x1FFu & ~(used[idxBox(i)] | used[9 + idxRow(i)] | used[18 + idxCol(i)]));
+      }
+    }
+    return 1;
+  }
+
+  // Removes 'digit' from the candidates of the unsolved peers (row, column, box) of cell 'idx'
+  // in place, leaving every other candidate as it is.
+  // Returns 0 in case of error, else 1.
+  EMSCRIPTEN_KEEPALIVE
+  int sudorix_solver_clear_peers(const uint8_t *values, uint16_t *cands, uint32_t idx, uint32_t digit) {
+    if (values == nullptr || cands == nullptr || idx >= 81 || digit < 1 || digit > 9) {
+      return 0;
+    }
+
+    const Mask keep = (Mask)~digitToBit((Digit)digit);
+    const Index *cells[3] = { ROW_CELLS[idxRow((Index)idx)], COL_CELLS[idxCol((Index)idx)],
+                              BOX_CELLS[idxBox((Index)idx)] };
+    for (const Index *unit : cells) {
+      for (int k = 0; k < 9; k++) {
+        const Index p = unit[k];
+        if (p != (Index)idx && values[p] == 0) {
+          cands[p] &= keep;
+        }
+      }
+    }
+    return 1;
+  }
+
+  // Checks values[81] for completion and for digits repeated in a unit, writing out[5]:
+  //   out[0] = number of filled cells (81 = complete)
+  //   out[1] = 1 if a digit repeats in a unit, else 0 (then out[2..4] are 0)
+  //   out[2] = that unit (0..8 boxes, 9..17 rows, 18..26 columns, as in BoardAnalysis)
+  //   out[3] = the repeated digit
+  //   out[4] = the cell of its second occurrence
+  // Rows are checked first, then columns, then boxes.
+  // Returns 0 in case of error (value out of range), else 1.
+  EMSCRIPTEN_KEEPALIVE
+  int sudorix_solver_check_grid(const uint8_t *values, uint32_t *out, uint32_t out_words) {
+    if (values == nullptr || out == nullptr || out_words < 5) {
+      return 0;
+    }
+
+    uint32_t filled = 0;
+    for (int i = 0; i < 81; i++) {
+      if (values[i] > 9) {
+        return 0;
+      }
+      filled += values[i] ? 1u : 0u;
+    }
+
+    out[0] = filled;
+    out[1] = out[2] = out[3] = out[4] = 0;
+    for (int n = 0; n < BoardAnalysis::NUM_UNITS; n++) {
+      const int unit = (n + 9) % BoardAnalysis::NUM_UNITS;  // rows, columns, boxes
+      const Index *cells = BoardAnalysis::unitCells(unit);
+      Mask seen = 0;
+      for (int k = 0; k < 9; k++) {
+        const Digit v = values[cells[k]];
+        if (v == 0) {
+          continue;
+        }
+        const Mask bit = digitToBit(v);
+        if (seen & bit) {
+          out[1] = 1;
+          out[2] = (uint32_t)unit;
+          out[3] = v;
+          out[4] = (uint32_t)cells[k];
+          return 1;
+        }
+        seen |= bit;
+      }
+    }
+    return 1;
+  }
+
+  // Solves the board given in values/cands in place, using only techniques up to 'max_tier'
+  // (SUDORIX_TIER_ALL = every technique), until no technique applies.
+  // A board stalled at one tier can be passed again with a higher tier to resume from there.
+  // Returns 0 in case of error, else 1 (check values[] to know whether it is solved).
+  EMSCRIPTEN_KEEPALIVE
+  int sudorix_solver_run_tier(uint8_t *values, uint16_t *cands, uint32_t max_tier) {
+    if (values == nullptr || cands == nullptr) {
+      return 0;
+    }
+
+    SudokuBoard board;
+    if (!board.importFromBuffers(values, cands)) {
+      return 0;
+    }
+
+    g_maxTier = max_tier;
+    run_until_stuck(board);
+    g_maxTier = SUDORIX_TIER_ALL;
+
+    board.exportToBuffers(values, cands);
+    return 1;
+  }
+
+  // Solves 'count' puzzles stored back to back as 81 chars each (no terminators) in in81s,
+  // writing 81 chars per puzzle to out81s (same format as sudorix_solver_full, no terminators).
+  // Puzzles are propagated BoardBatch::LANES at a time with singles in vector lanes; lanes that
+  // stall are finished one by one by the full technique pipeline, and lanes that reach a
+  // contradiction are solved again from their givens exactly as sudorix_solver_full does, so
+  // every output slot is byte-identical to sudorix_solver_full, valid puzzle or not.
+  // A puzzle sudorix_solver_full rejects (malformed, conflicting, a cell without candidates)
+  // yields 81 '.' in its output slot.
+  // Returns 0 in case of error, else 1.
+  EMSCRIPTEN_KEEPALIVE
+  int sudorix_solver_full_batch(const char *in81s, char *out81s, uint32_t count) {
+    if (in81s == nullptr || out81s == nullptr) {
+      return 0;
+    }
+
+    BoardBatch batch;
+    Digit values[81];
+    Mask cands[81];
+    for (uint32_t base = 0; base < count; base += BoardBatch::LANES) {
+      bool loaded[BoardBatch::LANES];
+      for (int lane = 0; lane < BoardBatch::LANES; lane++) {
+        const uint32_t n = base + (uint32_t)lane;
+        loaded[lane] = n < count && batch.load(lane, in81s + (size_t)n * 81);
+        if (n < count && !loaded[lane]) {
+          std::memset(out81s + (size_t)n * 81, '.', 81);
+        }
+      }
+
+      batch.propagate();
+
+      for (int lane = 0; lane < BoardBatch::LANES; lane++) {
+        if (!loaded[lane]) {
+          continue;
+        }
+        char *out81 = out81s + (size_t)(base + (uint32_t)lane) * 81;
+        bool broken = batch.isContradicted(lane);
+        if (!broken) {
+          batch.exportLane(lane, values, cands);
+          if (!batch.isSolved(lane)) {
+            SudokuBoard board;
+            if (board.importFromBuffers(values, cands)) {
+              run_until_stuck(board);
+              board.exportToBuffers(values, cands);
+            }
+            broken = board_contradicted(values, cands);
+          }
+        }
+        if (broken) {
+          // past a contradiction the result depends on the order of the deductions, and the
+          // vector singles do not follow the scalar order: start over from the givens
+          char in81[82];
+          std::memcpy(in81, in81s + (size_t)(base + (uint32_t)lane) * 81, 81);
+          in81[81] = '\0';
+          SudokuBoard board;
+          if (!board.importFromString(in81)) {
+            std::memset(out81, '.', 81);
+            continue;
+          }
+          run_until_stuck(board);
+          board.exportToBuffers(values, cands);
+        }
+        for (int i = 0; i < 81; i++) {
+          out81[i] = values[i] ? (char)('0' + values[i]) : '.';
+        }
+      }
+    }
+
+    return 1;
+  }
+
+  // Finds a smallest set of cells whose values (from the solution), once revealed, let the
+  // logical pipeline solve in81 on its own: the "reveal a cell" assist. Writes out[]:
+  //   out[0]     = number of cells k (0 if the pipeline already solves the puzzle)
+  //   out[1..2k] = k pairs of cell and digit
+  // max_cells bounds the size of the set (0 = no bound), budget_us the search time (0 = none).
+  // Found sets are cached per puzzle (per thread), so asking again for a puzzle is free.
+  // Returns 1 if a set was found, SUDORIX_BUDGET_EXHAUSTED if the budget ran out first, 0 in
+  // case of error (malformed, conflicting or unsolvable puzzle, no set of at most max_cells
+  // cells, or out too small for the set).
+  EMSCRIPTEN_KEEPALIVE
+  int sudorix_solver_backdoor(const char *in81, uint32_t max_cells, uint32_t budget_us,
+                              uint32_t *out, uint32_t out_words) {
+    if (in81 == nullptr || out == nullptr || out_words < 1) {
+      return 0;
+    }
+
+    SudokuBoard board;
+    if (!board.importFromString(in81)) {
+      return 0;
+    }
+    Digit givens[81];
+    Mask cands[81];
+    board.exportToBuffers(givens, cands);
+
+    uint32_t hash = 2166136261u;  // FNV-1a
+    for (int i = 0; i < 81; i++) {
+      hash = (hash ^ givens[i]) * 16777619u;
+    }
+    BackdoorCacheEntry &entry = g_backdoorCache[hash % BACKDOOR_CACHE_SIZE];
+
+    if (!entry.used || std::memcmp(entry.givens, givens, sizeof(givens)) != 0) {
+      const auto deadline = budget_us ? std::chrono::steady_clock::now() + std::chrono::microseconds(budget_us)
+                                      : std::chrono::steady_clock::time_point::max();
+      BackdoorSearch search;
+      const BackdoorSearch::Status status = search.run(givens, (int)max_cells, deadline);
+      if (status == BackdoorSearch::TIMED_OUT) {
+        return SUDORIX_BUDGET_EXHAUSTED;
+      }
+      if (status != BackdoorSearch::FOUND) {
+        return 0;
+      }
+
+      entry.used = true;
+      std::memcpy(entry.givens, givens, sizeof(givens));
+      entry.count = (uint8_t)search.size();
+      for (int k = 0; k < search.size(); k++) {
+        entry.cells[k] = search.cell(k);
+        entry.digits[k] = search.digit(k);
+      }
+    }
+
+    if ((max_cells && entry.count > max_cells) || out_words < 1u + 2u * entry.count) {
+      return 0;
+    }
+    out[0] = entry.count;
+    for (uint32_t k = 0; k < entry.count; k++) {
+      out[1 + 2 * k] = (uint32_t)entry.cells[k];
+      out[2 + 2 * k] = entry.digits[k];
+    }
+    return 1;
+  }
+
+  // Checks that in81 is minimal: it has a unique solution and every given is necessary.
+  // Writes out[]:
+  //   out[0]     = number of solutions (0, 1, or 2 for two or more)
+  //   out[1]     = number of givens
+  //   out[2]     = number of redundant givens k (0 unless the solution is unique)
+  //   out[3..]   = their k cells
+  // The puzzle is minimal iff out[0] == 1 and out[2] == 0.
+  // Returns 1 if checked, 0 in case of error (malformed or conflicting puzzle, or out too
+  // small: 3 + number of givens words always suffice).
+  EMSCRIPTEN_KEEPALIVE
+  int sudorix_solver_minimality(const char *in81, uint32_t *out, uint32_t out_words) {
+    if (in81 == nullptr || out == nullptr || out_words < 3) {
+      return 0;
+    }
+
+    SudokuBoard board;
+    if (!board.importFromString(in81)) {
+      return 0;
+    }
+    Digit givens[81];
+    Mask cands[81];
+    board.exportToBuffers(givens, cands);
+
+    MinimalityCheck check;
+    if (check.run(givens) == MinimalityCheck::INVALID ||
+        out_words < 3u + (uint32_t)check.redundantCount()) {
+      return 0;
+    }
+    out[0] = (uint32_t)check.solutions();
+    out[1] = (uint32_t)check.givenCount();
+    out[2] = (uint32_t)check.redundantCount();
+    for (int k = 0; k < check.redundantCount(); k++) {
+      out[3 + k] = (uint32_t)check.redundant(k);
+    }
+    return 1;
+  }
+
+  // Serializes the step-by-step state (board + pending events) into buf.
+  // Blob layout:
+  //   [0]      version (SNAPSHOT_VERSION)
+  //   [1..103] board, see SudokuBoard::pack
+  //   u8       technique scan to resume (0xFF = none)
+  //   u16      position it resumes from (little endian, 0 if none)
+  //   u16      number of pending events (little endian)
+  //   events   u8 type, u8 reason, u8 count, then count x (u8 idx, u8 digit)
+  // Returns the number of bytes written, the required size if buf is null, 0 in case of error
+  // (including a buffer that is too small).
+  EMSCRIPTEN_KEEPALIVE
+  int sudorix_solver_snapshot(uint8_t *buf, uint32_t buf_size) {
+    std::vector<Event> events;
+    g_eventQueue.copyTo(events);
+
+    uint32_t size = 1u + (uint32_t)SudokuBoard::PACKED_SIZE + 3u + 2u;
+    for (Event &event : events) {
+      if (event.getNumberOfOperations() > 255) {
+        return 0;
+      }
+      size += 3u + 2u * (uint32_t)event.getNumberOfOperations();
+    }
+    if (events.size() > 0xFFFFu) {
+      return 0;
+    }
+
+    if (buf == nullptr) {
+      return (int)size;
+    }
+    if (buf_size < size) {
+      return 0;
+    }
+
+    uint8_t *p = buf;
+    *p++ = SNAPSHOT_VERSION;
+    g_sudokuBoard.pack(p);
+    p += SudokuBoard::PACKED_SIZE;
+    const bool resuming = g_resume.technique != NO_RESUME;
+    *p++ = resuming ? (uint8_t)g_resume.technique : 0xFFu;
+    *p++ = resuming ? (uint8_t)(g_resume.cursor & 0xFFu) : 0u;
+    *p++ = resuming ? (uint8_t)(g_resume.cursor >> 8) : 0u;
+    *p++ = (uint8_t)(events.size() & 0xFFu);
+    *p++ = (uint8_t)(events.size() >> 8);
+    for (Event &event : events) {
+      *p++ = (uint8_t)event.type;
+      *p++ = (uint8_t)event.reason;
+      *p++ = (uint8_t)event.getNumberOfOperations();
+      for (const Operation &op : event.getOperations()) {
+        *p++ = (uint8_t)op.idx;
+        *p++ = (uint8_t)op.digit;
+      }
+    }
+    return (int)size;
+  }
+
+  // Restores a state written by sudorix_solver_snapshot, replacing the current one.
+  // The blob is fully validated first; on error the current state is left untouched.
+  // Returns 0 in case of error, else 1.
+  EMSCRIPTEN_KEEPALIVE
+  int sudorix_solver_restore(const uint8_t *buf, uint32_t size) {
+    const uint32_t header = 1u + (uint32_t)SudokuBoard::PACKED_SIZE + 3u + 2u;
+    if (buf == nullptr || size < header || buf[0] != SNAPSHOT_VERSION) {
+      return 0;
+    }
+
+    SudokuBoard board;
+    if (!board.unpack(buf + 1)) {
+      return 0;
+    }
+
+    const uint8_t *p = buf + 1 + SudokuBoard::PACKED_SIZE;
+    const uint8_t *end = buf + size;
+    ResumeState resume = { NO_RESUME, 0 };
+    const uint32_t cursor = (uint32_t)p[1] | ((uint32_t)p[2] << 8);
+    if (p[0] != 0xFFu) {
+      if (p[0] >= NUM_TECHNIQUES || cursor == 0) {
+        return 0;
+      }
+      resume.technique = p[0];
+      resume.cursor = cursor;
+    } else if (cursor != 0) {
+      return 0;
+    }
+    p += 3;
+    const uint32_t numEvents = (uint32_t)p[0] | ((uint32_t)p[1] << 8);
+    p += 2;
+
+    EventQueue queue;
+    for (uint32_t e = 0; e < numEvents; e++) {
+      if (end - p < 3) {
+        return 0;
+      }
+      const uint8_t type = p[0];
+      const uint8_t reason = p[1];
+      const uint8_t count = p[2];
+      p += 3;
+      if ((type != (uint8_t)EventType::SetValue && type != (uint8_t)EventType::RemoveCandidate) ||
+          reason > (uint8_t)REASON_ID_MAX || count == 0 || end - p < 2 * count) {
+        return 0;
+      }
+      Event event((EventType)type, (ReasonId)reason);
+      for (uint8_t k = 0; k < count; k++) {
+        const uint8_t idx = p[0];
+        const uint8_t digit = p[1];
+        p += 2;
+        if (idx >= 81 || digit < 1 || digit > 9) {
+          return 0;
+        }
+        event.addOperation((Index)idx, digit);
+      }
+      queue.enqueue(board, event);
+    }
+    if (p != end) {
+      return 0;
+    }
+
+    g_sudokuBoard = board;
+    g_eventQueue = queue;
+    g_resume = resume;
+    return 1;
+  }
+
+  // Exports the board loaded by sudorix_solver_init_board, including all steps applied so far.
+  // Returns 0 in case of error, else 1.
+  EMSCRIPTEN_KEEPALIVE
+  int sudorix_solver_export_board(uint8_t *values, uint16_t *cands) {
+    if (values == nullptr || cands == nullptr) {
+      return 0;
+    }
+
+    g_sudokuBoard.exportToBuffers(values, cands);
+    return 1;
+  }
+
   // Calculate and return one step to solve the board given as input (both values and candidates are given).
   // Returns 0 in case of error or no event is produced, else 1.
   EMSCRIPTEN_KEEPALIVE
@@ -552,8 +1353,183 @@ extern "C"
 
     // Clear internal queue state for this hint computation.
     g_eventQueue = EventQueue();
+    reset_resume();
 
     const int ok = compute_next_event(board, out, out_words, false);
     return ok ? 1 : 0;
   }
+
+  // Like sudorix_solver_hint, but returns the easiest useful deduction instead of the first one:
+  // every technique up to 'max_tier' (SUDORIX_TIER_ALL = all of them) is run to completion,
+  // and the findings are ranked by tier, then by the number of placements that singles force
+  // right after them (lookahead), then by technique priority.
+  // The lookahead of all findings together is bounded by 'lookahead_us' microseconds
+  // (0 = rank without lookahead); findings not reached in time count as forcing nothing.
+  // Returns 0 in case of error or no event is produced, else 1.
+  EMSCRIPTEN_KEEPALIVE
+  int sudorix_solver_hint_best(const uint8_t *values,
+                               const uint16_t *cands,
+                               uint32_t *out,
+                               uint32_t out_words,
+                               uint32_t max_tier,
+                               uint32_t lookahead_us) {
+    if (values == nullptr || cands == nullptr || out == nullptr || out_words < 4) {
+      return 0;
+    }
+    out[0] = 0;
+    out[1] = 0;
+    out[2] = 0;
+    out[3] = 0;
+
+    SudokuBoard board;
+    if (!board.importFromBuffers(values, cands)) {
+      return 0;
+    }
+
+    // Clear internal queue state for this hint computation.
+    g_eventQueue = EventQueue();
+    reset_resume();
+
+    std::vector<HintCandidate> found;
+    std::vector<Event> events;
+    BoardAnalysis analysis(board);
+    for (size_t i = 0; i < NUM_TECHNIQUES; i++) {
+      if (max_tier != SUDORIX_TIER_ALL && TECHNIQUE_TIERS[i] > max_tier) {
+        continue;
+      }
+      for (uint32_t p = 0; p != TECHNIQUE_SCAN_DONE; p = TECHNIQUES[i](board, analysis, p)) {
+      }
+      events.clear();
+      g_eventQueue.copyTo(events);
+      g_eventQueue = EventQueue();
+      for (Event &event : events) {
+        found.push_back({ event, i, 0 });
+      }
+    }
+    if (found.empty()) {
+      return 0;
+    }
+
+    // Only candidates that can still win need a lookahead: the easiest tier present.
+    uint32_t bestTier = TECHNIQUE_TIERS[found[0].technique];
+    for (const HintCandidate &c : found) {
+      if (TECHNIQUE_TIERS[c.technique] < bestTier) {
+        bestTier = TECHNIQUE_TIERS[c.technique];
+      }
+    }
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::microseconds(lookahead_us);
+    for (HintCandidate &c : found) {
+      if (lookahead_us == 0 || std::chrono::steady_clock::now() >= deadline) {
+        break;
+      }
+      if (TECHNIQUE_TIERS[c.technique] == bestTier) {
+        c.followUp = lookahead_placements(board, c.event, deadline);
+      }
+    }
+
+    size_t best = 0;
+    for (size_t k = 1; k < found.size(); k++) {
+      if (hint_better(found[k], found[best])) {
+        best = k;
+      }
+    }
+
+    g_eventQueue.enqueue(board, found[best].event);
+    return drain_event(board, out, out_words, 0u, false) ? 1 : 0;
+  }
+
+  // Runs the techniques selected by 'techniques' (SudorixTechnique bits, SUDORIX_TECH_ALL = all)
+  // to completion on the board given as input, and writes every deduction found into out[],
+  // one after the other, each in the usual layout (4 header words + 2 words per operation,
+  // fromPrev = 0). A deduction repeating one already written for the same reason (e.g. the same
+  // hidden single seen from its box and its row) is skipped.
+  // Events are never split: writing stops at the first one that does not fit.
+  // If 'available' is not null it receives the number of deductions found; the output was
+  // truncated if it is larger than the return value.
+  // Returns the number of events written (0 if nothing was found, or if the first event does
+  // not fit), SUDORIX_INVALID_INPUT in case of error (null buffer, value out of range).
+  EMSCRIPTEN_KEEPALIVE
+  int sudorix_solver_hint_all(const uint8_t *values,
+                              const uint16_t *cands,
+                              uint32_t techniques,
+                              uint32_t *out,
+                              uint32_t out_words,
+                              uint32_t *available) {
+    if (available) {
+      *available = 0;
+    }
+    if (values == nullptr || cands == nullptr || out == nullptr) {
+      return SUDORIX_INVALID_INPUT;
+    }
+
+    SudokuBoard board;
+    if (!board.importFromBuffers(values, cands)) {
+      return SUDORIX_INVALID_INPUT;
+    }
+
+    // Clear internal queue state for this hint computation.
+    g_eventQueue = EventQueue();
+    reset_resume();
+
+    // every operation already reported: [reason][type][idx] -> digit bits
+    Mask reported[(size_t)REASON_ID_MAX + 1][2][81];
+    std::memset(reported, 0, sizeof(reported));
+
+    std::vector<Event> events;
+    BoardAnalysis analysis(board);
+    uint32_t used = 0;
+    uint32_t written = 0;
+    uint32_t found = 0;
+    bool full = false;
+    for (size_t i = 0; i < NUM_TECHNIQUES; i++) {
+      if (techniques != SUDORIX_TECH_ALL && (techniques & (1u << i)) == 0) {
+        continue;
+      }
+      for (uint32_t p = 0; p != TECHNIQUE_SCAN_DONE; p = TECHNIQUES[i](board, analysis, p)) {
+      }
+      events.clear();
+      g_eventQueue.copyTo(events);
+      g_eventQueue = EventQueue();
+
+      for (Event &event : events) {
+        Mask (&seen)[81] = reported[(size_t)event.reason][event.type == EventType::SetValue ? 0 : 1];
+        bool fresh = false;
+        for (const Operation &op : event.getOperations()) {
+          if ((seen[op.idx] & digitToBit(op.digit)) == 0) {
+            fresh = true;
+          }
+        }
+        if (!fresh) {
+          continue;
+        }
+        for (const Operation &op : event.getOperations()) {
+          seen[op.idx] |= digitToBit(op.digit);
+        }
+        found++;
+
+        const uint32_t words = 4u + 2u * (uint32_t)event.getNumberOfOperations();
+        if (full || used + words > out_words) {
+          full = true;
+          continue;
+        }
+        uint32_t *ev = out + used;
+        ev[0] = (uint32_t)event.type;
+        ev[1] = (uint32_t)event.reason;
+        ev[2] = 0;
+        ev[3] = (uint32_t)event.getNumberOfOperations();
+        uint32_t k = 4;
+        for (const Operation &op : event.getOperations()) {
+          ev[k++] = (uint32_t)op.idx;
+          ev[k++] = (uint32_t)op.digit;
+        }
+        used += words;
+        written++;
+      }
+    }
+
+    if (available) {
+      *available = found;
+    }
+    return (int)written;
+  }
 } // extern "C"
@@ -25,13 +25,15 @@ var business_logic = (() => {
    * ========================================================= */
   let wasmModule = null;
   let wasmSolveFull = null;      // cwrap'd function
-  let wasmSolveInit = null;      // cwrap'd function
   let wasmSolveNextStep = null;  // cwrap'd function
   let wasmSolveHint = null;      // cwrap'd function
-  let wasmBufValues = 0;         // malloc'ed pointers in WASM heap
-  let wasmBufCands  = 0;
-  let wasmBufOut    = 0;
+  let wasmSolveLoad = null;      // cwrap'd function
+  let wasmBoardRecalc = null;    // cwrap'd function
+  let wasmBoardClearPeers = null; // cwrap'd function
+  let wasmBoardCheck = null;     // cwrap'd function
+  let wasmBufOut    = 0;         // malloc'ed pointer in WASM heap
   const WASM_OUT_WORDS = 1024;
+  const WASM_HINT_LOOKAHEAD_US = 2000; // time allowed to rank hints by follow-up placements
 
   const WASM_REASON = {
     0: "Solver",
@@ -56,24 +58,32 @@ var business_logic = (() => {
     }).then((Module) => {
       wasmModule = Module;
       wasmSolveFull = wasmModule.cwrap("sudorix_solver_full", "number", ["number", "number"]);
-      wasmSolveInit = wasmModule.cwrap("sudorix_solver_init_board", "number", ["number"]);
       wasmSolveNextStep = wasmModule.cwrap("sudorix_solver_next_step", "number", ["number", "number"]);
-      wasmSolveHint = wasmModule.cwrap("sudorix_solver_hint", "number", ["number", "number", "number", "number"]);
+      wasmSolveHint = wasmModule.cwrap("sudorix_solver_hint_best", "number",
+                                       ["number", "number", "number", "number", "number", "number"]);
+      wasmSolveLoad = wasmModule.cwrap("sudorix_solver_load_board", "number", ["number", "number"]);
+      wasmBoardRecalc = wasmModule.cwrap("sudorix_solver_recalc_candidates", "number", ["number", "number"]);
+      wasmBoardClearPeers = wasmModule.cwrap("sudorix_solver_clear_peers", "number",
+                                             ["number", "number", "number", "number"]);
+      wasmBoardCheck = wasmModule.cwrap("sudorix_solver_check_grid", "number", ["number", "number", "number"]);
 
-      wasmBufValues = wasmModule._malloc(81);          // uint8_t[81]
-      wasmBufCands  = wasmModule._malloc(81 * 2);      // uint16_t[81]
-      wasmBufInStr  = wasmModule._malloc(82);          // char[81] + '\0'
       wasmBufOut    = wasmModule._malloc(WASM_OUT_WORDS * 4); // uint32_t[WASM_OUT_WORDS]
 
+      // from now on the board lives in WASM memory, shared with the solver
+      board.attachWasm(wasmModule);
+
       appendLog("WASM: solvilo preta.");
       return Module;
     }).catch((e) => {
       appendLog("WASM: malsukcesis ŝargi solvilon: " + (e && e.message ? e.message : String(e)));
       wasmModule = null;
       wasmSolveFull = null;
-      wasmSolveInit = null;
       wasmSolveNextStep = null;
       wasmSolveHint = null;
+      wasmSolveLoad = null;
+      wasmBoardRecalc = null;
+      wasmBoardClearPeers = null;
+      wasmBoardCheck = null;
     });
   }
 
@@ -103,28 +113,37 @@ var business_logic = (() => {
   }
 
   function wasmInitBoard(boardRef) {
-    if (!wasmModule || !wasmSolveInit) {
-      return null;
+    if (!wasmModule || !wasmSolveLoad || !boardRef.isWasmBacked()) {
+      return false;
     }
 
-    const s = boardRef.exportToString();
-    const enc = new TextEncoder();
-    const bytes = enc.encode(String(s || ""));
-    // Copy at most 81 chars; terminate.
-    const max = Math.min(bytes.length, 81);
-    for (let i = 0; i < max; i++) {
-      wasmModule.HEAPU8[wasmBufInStr + i] = bytes[i];
-    }
-    for (let i = max; i < 81; i++) {
-      wasmModule.HEAPU8[wasmBufInStr + i] = 46; // '.'
-    }
-    wasmModule.HEAPU8[wasmBufInStr + 81] = 0;
+    // the board already lives in WASM memory: the solver loads it in place
+    return wasmSolveLoad(boardRef.valuesPtr(), boardRef.candsPtr()) !== 0;
+  }
 
-    const ok = wasmSolveInit(wasmBufInStr);
-    if (!ok) {
-      // Boh
+  /* ---- board helpers (C++ working in place on the board arrays) ---- */
+  function wasmRecalcCandidates(ptrValues, ptrCands) {
+    return !!wasmBoardRecalc && wasmBoardRecalc(ptrValues, ptrCands) !== 0;
+  }
+
+  function wasmClearPeers(ptrValues, ptrCands, idx, digit) {
+    return !!wasmBoardClearPeers && wasmBoardClearPeers(ptrValues, ptrCands, idx, digit) !== 0;
+  }
+
+  function wasmCheckGrid(ptrValues) {
+    if (!wasmBoardCheck || !wasmBoardCheck(ptrValues, wasmBufOut, WASM_OUT_WORDS)) {
+      return null;
     }
-    return null;
+
+    // out[0]=filled, out[1]=conflict, out[2]=unit, out[3]=digit, out[4]=idx
+    const out = wasmModule.HEAPU32.subarray(wasmBufOut >> 2, (wasmBufOut >> 2) + 5);
+    return {
+      filled: out[0] >>> 0,
+      conflict: (out[1] >>> 0) !== 0,
+      unit: out[2] >>> 0,
+      digit: out[3] >>> 0,
+      idx: out[4] >>> 0
+    };
   }
 
   function wasmComputeNextStep() {
@@ -170,22 +189,14 @@ var business_logic = (() => {
   }
 
   function wasmComputeHint(board) {
-    if (!wasmModule || !wasmSolveHint) {
+    if (!wasmModule || !wasmSolveHint || !board.isWasmBacked()) {
       return null;
     }
 
-    // Prepare inputs (snapshot board)
-    let inValues = new Uint8Array(81);
-    let inCands  = new Uint16Array(81);
-    for (let i = 0; i < 81; i++) {
-      inValues[i] = board.getValue(i) & 0xFF;
-      inCands[i]  = board.getCandidateMask(i) & 0xFFFF;
-    }
-
-    wasmModule.HEAPU8.set(inValues, wasmBufValues);
-    wasmModule.HEAPU16.set(inCands, wasmBufCands >> 1);
-
-    const ok = wasmSolveHint(wasmBufValues, wasmBufCands, wasmBufOut, WASM_OUT_WORDS);
+    // easiest deduction available, not just the first one found (tier 0 = all techniques);
+    // the board is read in place from WASM memory
+    const ok = wasmSolveHint(board.valuesPtr(), board.candsPtr(), wasmBufOut, WASM_OUT_WORDS, 0,
+                             WASM_HINT_LOOKAHEAD_US);
     if (!ok) {
       return null;
     }
@@ -349,19 +360,18 @@ var business_logic = (() => {
   });
 
   /* =========================================================
-   * OOP: SudokuCell (private state)
+   * OOP: SudokuCell (private state: given flag and colors)
+   *
+   * Values and candidates are not stored per cell: they live in the
+   * board's typed arrays, shared with the WASM solver.
    * ========================================================= */
   class SudokuCell {
-    #value;
-    #candidateMask;
     #given;
 
     #cellColorIndex;
     #candidateColorIndex; /* length 9 array */
 
     constructor() {
-      this.#value = 0;          // value 0..9
-      this.#candidateMask = 0;  // candidate mask - start without candidates
       this.#given = false;      // imported as fixed clue
 
       /* cell background color (palette index or -1 for none) */
@@ -370,15 +380,7 @@ var business_logic = (() => {
       this.#candidateColorIndex = Array.from({ length: 9 }, () => -1);
     }
 
-    /* ---- value / given ---- */
-    getValue() {
-      return this.#value;
-    }
-
-    isSolved() {
-      return this.#value !== 0;
-    }
-
+    /* ---- given ---- */
     isGiven() {
       return this.#given;
     }
@@ -387,62 +389,6 @@ var business_logic = (() => {
       this.#given = !!isGiven;
     }
 
-    setValue(digit) {
-      this.#value = digit;
-      if (digit === 0) {
-        /* keep candidates as-is; solver / recalc can fill later */
-        return;
-      }
-      this.#candidateMask = digitToBit(digit);
-    }
-
-    clearValue() {
-      this.#value = 0;
-      /* do not force candidates here */
-    }
-
-    /* ---- candidates ---- */
-    getCandidateMask() {
-      return this.#candidateMask & 0x1FF;
-    }
-
-    setCandidateMask(mask) {
-      this.#candidateMask = (mask & 0x1FF);
-    }
-
-    hasCandidate(digit) {
-      return !!(this.#candidateMask & digitToBit(digit));
-    }
-
-    enableCandidate(digit) {
-      this.#candidateMask |= digitToBit(digit);
-    }
-
-    disableCandidate(digit) {
-      this.#candidateMask &= ~digitToBit(digit);
-
-      /* If the candidate is removed, remove its candidate-color too */
-      this.#candidateColorIndex[digit - 1] = -1;
-    }
-
-    toggleCandidate(digit) {
-      const bit = digitToBit(digit);
-      const wasOn = !!(this.#candidateMask & bit);
-
-      this.#candidateMask ^= bit;
-
-      /* If candidate removed, remove its color too */
-      if (wasOn && !(this.#candidateMask & bit)) {
-        this.#candidateColorIndex[digit - 1] = -1;
-      }
-
-      return !wasOn;
-    }
-
-    countCandidates() {
-      return countBits9(this.#candidateMask);
-    }
-
     /* ---- coloring ---- */
     getCellColorIndex() {
       return this.#cellColorIndex;
@@ -489,14 +435,80 @@ var business_logic = (() => {
 
   /* =========================================================
    * OOP: SudokuBoard
+   *
+   * Values and candidates are two typed arrays with the layout of the C API
+   * (uint8_t values[81], uint16_t cands[81]). Once the WASM module is loaded,
+   * attachWasm() moves them into WASM memory: the board becomes a view over
+   * it, so recalc / peer-clear / check run in C++ on the very same arrays and
+   * the solver reads the board without any copy. Until then (or if the module
+   * fails to load) the same helpers run in plain JS on the arrays.
    * ========================================================= */
   class SudokuBoard {
     #cells;
+    #values;
+    #cands;
     #filledCount;
 
+    #wasm;       // module owning the arrays, null before attachWasm
+    #ptrValues;
+    #ptrCands;
+
     constructor() {
       this.#cells = Array.from({ length: 81 }, () => new SudokuCell());
+      this.#values = new Uint8Array(81);
+      this.#cands = new Uint16Array(81);
       this.#filledCount = 0;
+
+      this.#wasm = null;
+      this.#ptrValues = 0;
+      this.#ptrCands = 0;
+    }
+
+    /* ---- WASM memory ---- */
+    attachWasm(module) {
+      if (this.#wasm) {
+        return;
+      }
+      const ptrValues = module._malloc(81);      // uint8_t[81]
+      const ptrCands = module._malloc(81 * 2);   // uint16_t[81]
+      module.HEAPU8.set(this.#values, ptrValues);
+      module.HEAPU16.set(this.#cands, ptrCands >> 1);
+
+      this.#wasm = module;
+      this.#ptrValues = ptrValues;
+      this.#ptrCands = ptrCands;
+      this.#bindViews();
+    }
+
+    isWasmBacked() {
+      return this.#wasm !== null;
+    }
+
+    valuesPtr() {
+      return this.#ptrValues;
+    }
+
+    candsPtr() {
+      return this.#ptrCands;
+    }
+
+    #bindViews() {
+      const buffer = this.#wasm.HEAPU8.buffer;
+      this.#values = new Uint8Array(buffer, this.#ptrValues, 81);
+      this.#cands = new Uint16Array(buffer, this.#ptrCands, 81);
+    }
+
+    // Growing WASM memory detaches the old views: rebind them on next use.
+    #vals() {
+      if (this.#wasm && this.#values.buffer !== this.#wasm.HEAPU8.buffer) {
+        this.#bindViews();
+      }
+      return this.#values;
+    }
+
+    #masks() {
+      this.#vals();
+      return this.#cands;
     }
 
     /* ---- meta ---- */
@@ -519,11 +531,11 @@ var business_logic = (() => {
 
     /* ---- query API ---- */
     getValue(idx) {
-      return this.#cellAt(idx).getValue();
+      return this.#vals()[idx];
     }
 
     isSolved(idx) {
-      return this.#cellAt(idx).isSolved();
+      return this.#vals()[idx] !== 0;
     }
 
     isGiven(idx) {
@@ -531,15 +543,15 @@ var business_logic = (() => {
     }
 
     getCandidateMask(idx) {
-      return this.#cellAt(idx).getCandidateMask();
+      return this.#masks()[idx] & 0x1FF;
     }
 
     hasCandidate(idx, digit) {
-      return this.#cellAt(idx).hasCandidate(digit);
+      return !!(this.#masks()[idx] & digitToBit(digit));
     }
 
     countCandidates(idx) {
-      return this.#cellAt(idx).countCandidates();
+      return countBits9(this.#masks()[idx]);
     }
 
     getCellColorIndex(idx) {
@@ -552,11 +564,11 @@ var business_logic = (() => {
 
     /* ---- mutation API ---- */
     resetAll() {
+      this.#vals().fill(0);
+      this.#masks().fill(0);
       for (let i = 0; i < 81; i++) {
         const cell = this.#cellAt(i);
         cell.setGiven(false);
-        cell.setValue(0);
-        cell.setCandidateMask(0);
         cell.clearAllColors();
       }
       this.#filledCount = 0;
@@ -585,6 +597,8 @@ var business_logic = (() => {
       }
 
       /* overwrite everything */
+      const values = this.#vals();
+      const cands = this.#masks();
       this.#filledCount = 0;
 
       for (let i = 0; i < 81; i++) {
@@ -592,60 +606,52 @@ var business_logic = (() => {
         const cell = this.#cellAt(i);
 
         cell.clearAllColors();
-
-        if (d === 0) {
-          cell.setGiven(false);
-          cell.setValue(0);
-          cell.setCandidateMask(0);
-          continue;
+        cell.setGiven(d !== 0);
+        values[i] = d;
+        cands[i] = d ? digitToBit(d) : 0;
+        if (d) {
+          this.#filledCount++;
         }
-
-        cell.setGiven(true);
-        cell.setValue(d);
-        cell.setCandidateMask(digitToBit(d));
-        this.#filledCount++;
       }
 
       return { ok: true };
     }
 
     exportToString() {
+      const values = this.#vals();
       let text = "";
       for (let i = 0; i < 81; i++) {
-        const cell = this.#cellAt(i);
-        text += cell.isSolved() ? cell.getValue() : ".";
+        text += values[i] ? values[i] : ".";
       }
       return text;
     }
 
     setManualValue(idx, digit) {
-      const cell = this.#cellAt(idx);
-      if (cell.isGiven()) {
+      if (this.#cellAt(idx).isGiven()) {
         return { ok: false, reason: "given" };
       }
 
-      const prev = cell.getValue();
+      const values = this.#vals();
+      const prev = values[idx];
 
-      /* toggle-to-clear if same value */
+      /* toggle-to-clear if same value (candidates are kept as-is; recalc can fill them later) */
       if (digit !== 0 && prev === digit) {
-        cell.clearValue();
-        if (prev !== 0) {
-          this.#filledCount--;
-        }
+        values[idx] = 0;
+        this.#filledCount--;
         return { ok: true, changed: true, action: "clear" };
       }
 
       if (digit === 0) {
         if (prev !== 0) {
-          cell.clearValue();
+          values[idx] = 0;
           this.#filledCount--;
           return { ok: true, changed: true, action: "clear" };
         }
         return { ok: true, changed: false, action: "noop" };
       }
 
-      cell.setValue(digit);
-      cell.setCandidateMask(digitToBit(digit));
+      values[idx] = digit;
+      this.#masks()[idx] = digitToBit(digit);
 
       if (prev === 0) {
         this.#filledCount++;
@@ -656,64 +662,78 @@ var business_logic = (() => {
 
     toggleManualCandidate(idx, digit) {
       const cell = this.#cellAt(idx);
-      if (cell.isGiven() || cell.isSolved()) {
+      if (cell.isGiven() || this.isSolved(idx)) {
         return { ok: false, reason: "notEditable" };
       }
 
-      const nowOn = cell.toggleCandidate(digit);
+      const cands = this.#masks();
+      const bit = digitToBit(digit);
+      cands[idx] ^= bit;
+      const nowOn = !!(cands[idx] & bit);
+
+      /* If candidate removed, remove its color too */
+      if (!nowOn) {
+        cell.clearCandidateColor(digit);
+      }
       return { ok: true, changed: true, nowOn };
     }
 
     removeCandidate(idx, digit) {
       const cell = this.#cellAt(idx);
-      if (cell.isGiven() || cell.isSolved()) {
+      if (cell.isGiven() || this.isSolved(idx)) {
         return { ok: false, changed: false };
       }
-      if (!cell.hasCandidate(digit)) {
+      if (!this.hasCandidate(idx, digit)) {
         return { ok: true, changed: false };
       }
-      cell.disableCandidate(digit);
+      this.#masks()[idx] &= ~digitToBit(digit);
+      cell.clearCandidateColor(digit);
       return { ok: true, changed: true };
     }
 
-    /* ---- candidates management ---- */
+    /* ---- candidates management (C++ on the shared arrays, JS without WASM) ---- */
+    // Recompute candidates from values only (basic elimination).
+    // An empty cell may end up with no candidate if values conflict; that is OK.
     recalcAllCandidatesFromValues() {
-      // Recompute candidates from values only (basic elimination)
-      for (let i = 0; i < 81; i++) {
-        const cell = this.#cellAt(i);
+      if (this.#wasm !== null && wasmRecalcCandidates(this.#ptrValues, this.#ptrCands)) {
+        return true;
+      }
 
-        if (cell.isSolved()) {
-          cell.setCandidateMask(digitToBit(cell.getValue()));
+      const values = this.#vals();
+      const cands = this.#masks();
+      for (let i = 0; i < 81; i++) {
+        if (values[i]) {
+          cands[i] = digitToBit(values[i]);
           continue;
         }
-
         let mask = ALL_CANDIDATES_MASK;
         for (const p of PEERS[i]) {
-          const pv = this.getValue(p);
-          if (pv) {
-            mask &= ~digitToBit(pv);
+          if (values[p]) {
+            mask &= ~digitToBit(values[p]);
           }
         }
-        cell.setCandidateMask(mask); // may become 0 if contradiction; that is OK
+        cands[i] = mask;
       }
+      return true;
     }
 
     // Auto-clear "soft" update.
     // Removes the placed digit from candidates in peers ONLY.
     // Does NOT re-add any candidate bits that the user manually removed.
+    // Returns the peers that lost the candidate.
     autoClearPeersAfterPlacement(idx, digit) {
-      const bit = digitToBit(digit);
-      // Remove digit from all peers' candidate masks (only if the peer is not filled).
-      for (const p of PEERS[idx]) {
-        const cell = this.#cellAt(p);
-        if (cell.isSolved()) {
-          continue;
-        }
-        if (cell.getCandidateMask() & bit) {
-          /* do not touch background here */
-          cell.disableCandidate(digit);
+      const affected = PEERS[idx].filter((p) => !this.isSolved(p) && this.hasCandidate(p, digit));
+      if (this.#wasm === null || !wasmClearPeers(this.#ptrValues, this.#ptrCands, idx, digit)) {
+        const cands = this.#masks();
+        for (const p of affected) {
+          cands[p] &= ~digitToBit(digit);
         }
       }
+      /* a removed candidate loses its color, as with removeCandidate */
+      for (const p of affected) {
+        this.#cellAt(p).clearCandidateColor(digit);
+      }
+      return affected;
     }
 
     /* ---- coloring ---- */
@@ -734,47 +754,50 @@ var business_logic = (() => {
     }
 
     /* ---- check ---- */
-    checkSolvedGrid() {
-      // 1) Must be complete
+    // Same report as wasmCheckGrid: units numbered 0..8 boxes, 9..17 rows, 18..26 columns,
+    // checked rows first, then columns, then boxes.
+    #checkGridJs() {
+      const values = this.#vals();
+      const report = { filled: 0, conflict: false, unit: 0, digit: 0, idx: 0 };
       for (let i = 0; i < 81; i++) {
-        if (!this.getValue(i)) {
-          return { ok: false, msg: "Ne finita: estas malplenaj ĉeloj. Ne eblas taksi la kompletan solvon." };
+        if (values[i]) {
+          report.filled++;
         }
       }
 
-      // Helper: check duplicates in a unit
-      const seen = new Array(10);
-
-      const checkUnit = (indices, label) => {
-        seen.fill(false);
-        for (const idx of indices) {
-          const v = this.getValue(idx);
-          if (v < 1 || v > 9) {
-            return { ok: false, msg: `Eraro: nevalida valoro en ${label}.` };
+      const units = [[UNITS.rows, 9], [UNITS.cols, 18], [UNITS.boxs, 0]];
+      for (const [list, first] of units) {
+        for (let u = 0; u < 9; u++) {
+          let seen = 0;
+          for (const idx of list[u]) {
+            const v = values[idx];
+            if (!v) {
+              continue;
+            }
+            if (seen & digitToBit(v)) {
+              return { filled: report.filled, conflict: true, unit: first + u, digit: v, idx };
+            }
+            seen |= digitToBit(v);
           }
-          if (seen[v]) {
-            const { r, c } = idxToRC(idx);
-            return { ok: false, msg: `Eraro: duobligo de la numero ${v} en ${label} (ekz. r${r}c${c}).` };
-          }
-          seen[v] = true;
         }
-        return { ok: true, msg: "" };
-      };
-
-      // 2) Check rows/cols/boxes
-      for (let r = 0; r < 9; r++) {
-        const res = checkUnit(UNITS.rows[r], `vico ${r + 1}`);
-        if (!res.ok) { return res; }
       }
+      return report;
+    }
 
-      for (let c = 0; c < 9; c++) {
-        const res = checkUnit(UNITS.cols[c], `kolumno ${c + 1}`);
-        if (!res.ok) { return res; }
+    checkSolvedGrid() {
+      const report = (this.#wasm !== null && wasmCheckGrid(this.#ptrValues)) || this.#checkGridJs();
+
+      // 1) Must be complete
+      if (report.filled < 81) {
+        return { ok: false, msg: "Ne finita: estas malplenaj ĉeloj. Ne eblas taksi la kompletan solvon." };
       }
 
-      for (let b = 0; b < 9; b++) {
-        const res = checkUnit(UNITS.boxs[b], `bloko ${b + 1}`);
-        if (!res.ok) { return res; }
+      // 2) No digit twice in a row/col/box
+      if (report.conflict) {
+        const u = report.unit;
+        const label = (u < 9) ? `bloko ${u + 1}` : (u < 18) ? `vico ${u - 9 + 1}` : `kolumno ${u - 18 + 1}`;
+        const { r, c } = idxToRC(report.idx);
+        return { ok: false, msg: `Eraro: duobligo de la numero ${report.digit} en ${label} (ekz. r${r}c${c}).` };
       }
 
       return { ok: true, msg: "Ĝusta solvo: neniu duobligo trovita kaj krado kompleta." };
@@ -822,6 +845,7 @@ var business_logic = (() => {
   let highlightDigit = 0;
 
   /* solver state */
+  const SOLVE_TICK_MS = 250; // auto-solve playback: one event per tick
   let roundNumber = 0;
   let solveTimer = null;
 
@@ -834,10 +858,18 @@ var business_logic = (() => {
   /* =========================================================
    * Logging / Modals
    * ========================================================= */
+  let logScrollFrameId = 0;
+
   function appendLog(line) {
     const ts = new Date().toISOString().slice(11, 19);
     logEl.value += `[${ts}] ${line}\n`;
-    logEl.scrollTop = logEl.scrollHeight;
+    /* reading scrollHeight forces a layout: do it once per frame, not once per line */
+    if (!logScrollFrameId) {
+      logScrollFrameId = requestAnimationFrame(() => {
+        logScrollFrameId = 0;
+        logEl.scrollTop = logEl.scrollHeight;
+      });
+    }
   }
 
   function openCheckModal(msg) {
@@ -1194,11 +1226,37 @@ var business_logic = (() => {
   }
 
   function renderAll() {
+    /* everything is redrawn now: nothing left for the next frame */
+    dirtyCells.clear();
     for (let i = 0; i < 81; i++) {
       renderCell(i);
     }
   }
 
+  /* Dirty-cell rendering: cells changed by solver events (the event ops plus the
+     peers that lost a candidate) are collected and redrawn once per animation frame,
+     so fast playback rebuilds only those cells however many steps ran in between.
+     Highlights are per-cell, so redrawing the changed cells updates them too. */
+  const dirtyCells = new Set();
+  let renderFrameId = 0;
+
+  function renderCellsNextFrame(indices) {
+    for (const idx of indices) {
+      dirtyCells.add(idx);
+    }
+    if (!renderFrameId && dirtyCells.size) {
+      renderFrameId = requestAnimationFrame(flushDirtyCells);
+    }
+  }
+
+  function flushDirtyCells() {
+    renderFrameId = 0;
+    for (const idx of dirtyCells) {
+      renderCell(idx);
+    }
+    dirtyCells.clear();
+  }
+
   function buildGridUI() {
     gridEl.innerHTML = "";
     for (let i = 0; i < 81; i++) {
@@ -1306,10 +1364,9 @@ var business_logic = (() => {
     renderCell(selectedIdx);
 
     if (optAutoClearEl.checked && digit !== 0 && res.action === "set") {
-      board.autoClearPeersAfterPlacement(selectedIdx, digit);
-      /* render peers quickly */
-      for (const p of PEERS[selectedIdx]) {
-        renderCell(p);
+      const affected = board.autoClearPeersAfterPlacement(selectedIdx, digit);
+      if (affected) {
+        renderCellsNextFrame(affected);
       }
     }
 
@@ -1392,7 +1449,8 @@ var business_logic = (() => {
     }
   }
 
-  function applyEvent(ev) {
+  // Applies a solver event to the board; cells it changes are added to 'dirty' (a Set) if given.
+  function applyEvent(ev, dirty) {
     if (!ev || !ev.ops || ev.ops.length === 0) {
       return false;
     }
@@ -1421,8 +1479,14 @@ var business_logic = (() => {
         appendLog(`Round ${roundNumber} - ${ev.reason || "Solver"}: r${r}c${c} = ${digit}`);
 
         /* update candidates */
-        board.autoClearPeersAfterPlacement(idx, digit);
+        const affected = board.autoClearPeersAfterPlacement(idx, digit);
 
+        if (dirty) {
+          dirty.add(idx);
+          for (const p of affected || []) {
+            dirty.add(p);
+          }
+        }
         any = true;
       }
 
@@ -1443,6 +1507,9 @@ var business_logic = (() => {
         if (res.ok && res.changed) {
           removedCount++;
           any = true;
+          if (dirty) {
+            dirty.add(idx);
+          }
         }
       }
 
@@ -1457,7 +1524,7 @@ var business_logic = (() => {
   }
 
   function ensureWasmReadyOrNotify() {
-    if (wasmModule && wasmSolveFull && wasmSolveNextStep && wasmSolveInit && wasmSolveHint) {
+    if (wasmModule && wasmSolveFull && wasmSolveNextStep && wasmSolveLoad && wasmSolveHint) {
       return true;
     }
 
@@ -1483,9 +1550,10 @@ var business_logic = (() => {
       roundNumber++;
     }
 
-    const did = applyEvent(ev);
+    const dirty = new Set();
+    const did = applyEvent(ev, dirty);
     if (did) {
-      renderAll();
+      renderCellsNextFrame(dirty);
       if (ev.ops && ev.ops.length) {
         for (var op of ev.ops) {
           flashCell(op.idx, ev.type);
@@ -1516,7 +1584,7 @@ var business_logic = (() => {
         appendLog("Solvilo: halti (neniu plia evento).");
         stopSolving();
       }
-    }, 250);
+    }, SOLVE_TICK_MS);
   }
 
   function solveWasmFull() {
@@ -1558,8 +1626,9 @@ var business_logic = (() => {
       roundNumber++;
     }
 
-    applyEvent(ev);
-    renderAll();
+    const dirty = new Set();
+    applyEvent(ev, dirty);
+    renderCellsNextFrame(dirty);
     if (ev.ops && ev.ops.length) {
       for (var op of ev.ops) {
         flashCell(op.idx, ev.type);
@@ -1651,8 +1720,7 @@ var business_logic = (() => {
 
     highlightDigit = 0;
 
-    if (optPrefillEl.checked) {
-      board.recalcAllCandidatesFromValues();
+    if (optPrefillEl.checked && board.recalcAllCandidatesFromValues()) {
       appendLog("Enporto: Sudoku ŝargita. Antaŭplenigo aktiva -> kandidatoj kalkulitaj.");
     } else {
       appendLog("Enporto: Sudoku ŝargita. Kandidatoj ne kalkulitaj (premu 'Rekalkuli kandidatojn' se vi volas).");
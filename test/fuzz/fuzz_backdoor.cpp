@@ -0,0 +1,62 @@
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "solver.hpp"
+#include "fuzz_common.hpp"
+
+// sudorix_solver_backdoor: arbitrary text in, a set of revealed cells out.
+// Control bytes: out_words (raw, so sets that do not fit are tried), max_cells (raw,
+// 0 = no bound), budget in units of 200 us (always bounded, so an input cannot hang).
+// Nothing may be written past out_words, nor anywhere unless a set is returned; a returned
+// set must fit the limits, reveal empty cells only, and let sudorix_solver_full solve the
+// puzzle. Asking again must hit the cache and return the same set.
+static constexpr uint32_t GUARD = 8;
+static constexpr uint32_t SENTINEL = 0xA5A5A5A5u;
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+  const uint8_t *rest = nullptr;
+  size_t restSize = 0;
+  const std::string in = fuzzSplitText(data, size, &rest, &restSize);
+  const uint32_t outWords = restSize > 0 ? rest[0] : 163;
+  const uint32_t maxCells = restSize > 1 ? rest[1] : 0;
+  const uint32_t budgetUs = restSize > 2 ? (rest[2] + 1u) * 200u : 20000u;
+
+  std::vector<uint32_t> out(outWords + GUARD, SENTINEL);
+  const int found = sudorix_solver_backdoor(in.c_str(), maxCells, budgetUs, out.data(), outWords);
+  FUZZ_CHECK(found == 0 || found == 1 || found == SUDORIX_BUDGET_EXHAUSTED);
+  for (size_t k = found == 1 ? outWords : 0; k < out.size(); k++) {
+    FUZZ_CHECK(out[k] == SENTINEL);
+  }
+  if (found != 1) {
+    return 0;
+  }
+
+  const uint32_t count = out[0];
+  FUZZ_CHECK(1u + 2u * count <= outWords);
+  FUZZ_CHECK(maxCells == 0 || count <= maxCells);
+
+  uint8_t values[81];
+  uint16_t cands[81];
+  FUZZ_CHECK(sudorix_solver_parse_board(in.c_str(), values, cands) == 1);
+  for (uint32_t k = 0; k < count; k++) {
+    const uint32_t idx = out[1 + 2 * k];
+    const uint32_t digit = out[2 + 2 * k];
+    FUZZ_CHECK(idx < 81 && values[idx] == 0);
+    FUZZ_CHECK(digit >= 1 && digit <= 9);
+    values[idx] = (uint8_t)digit;
+  }
+  char revealed[82];
+  for (int i = 0; i < 81; i++) {
+    revealed[i] = values[i] ? (char)('0' + values[i]) : '.';
+  }
+  revealed[81] = '\0';
+  char out81[82];
+  FUZZ_CHECK(sudorix_solver_full(revealed, out81) == 1);
+  FUZZ_CHECK(std::memchr(out81, '.', 81) == nullptr);
+
+  std::vector<uint32_t> again(outWords, SENTINEL);
+  FUZZ_CHECK(sudorix_solver_backdoor(in.c_str(), maxCells, budgetUs, again.data(), outWords) == 1);
+  FUZZ_CHECK(std::memcmp(again.data(), out.data(), (1u + 2u * count) * sizeof(uint32_t)) == 0);
+  return 0;
+}
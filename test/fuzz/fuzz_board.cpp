@@ -0,0 +1,120 @@
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "solver.hpp"
+#include "fuzz_common.hpp"
+
+// Board-editing helpers of the UI on caller-owned buffers: sudorix_solver_check_grid,
+// sudorix_solver_recalc_candidates, sudorix_solver_clear_peers, then
+// sudorix_solver_load_board + sudorix_solver_next_step.
+// Input: 81 value bytes ('1'..'9' -> digit, '0'/'.' -> empty, any other byte passed
+// through raw), optional '\n', then up to 162 bytes taken raw as the candidate masks,
+// then control bytes: check_grid out[] capacity, clear_peers cell and digit (raw, so
+// out-of-range ones are tried too), number of steps.
+// Puzzle lines from the test files are therefore valid seeds.
+static bool sameUnit(int a, int b) {
+  return a / 9 == b / 9 || a % 9 == b % 9 || (a / 27 == b / 27 && (a % 9) / 3 == (b % 9) / 3);
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+  if (size < 81) {
+    return 0;
+  }
+
+  uint8_t values[81];
+  bool inRange = true;
+  for (int i = 0; i < 81; i++) {
+    const uint8_t b = data[i];
+    if (b >= '1' && b <= '9') {
+      values[i] = (uint8_t)(b - '0');
+    } else if (b == '0' || b == '.') {
+      values[i] = 0;
+    } else {
+      values[i] = b;
+    }
+    inRange = inRange && values[i] <= 9;
+  }
+
+  size_t pos = 81;
+  if (pos < size && data[pos] == '\n') {
+    pos++;
+  }
+  uint16_t cands[81];
+  std::memset(cands, 0, sizeof(cands));
+  uint8_t *candBytes = reinterpret_cast<uint8_t *>(cands);
+  for (size_t k = 0; k < sizeof(cands) && pos < size; k++, pos++) {
+    candBytes[k] = data[pos];
+  }
+  const uint8_t *ctl = data + pos;
+  const size_t ctlSize = size - pos;
+  const uint32_t checkWords = ctlSize > 0 ? ctl[0] : 5;
+  const uint32_t peerIdx = ctlSize > 1 ? ctl[1] : 40;
+  const uint32_t peerDigit = ctlSize > 2 ? ctl[2] : 5;
+  const int steps = ctlSize > 3 ? ctl[3] : 20;
+
+  // check_grid: nothing written past out_words, a reported repeat is a real one
+  std::vector<uint32_t> check(checkWords + 4u, 0xA5A5A5A5u);
+  const int checked = sudorix_solver_check_grid(values, check.data(), checkWords);
+  for (size_t k = checked ? 5 : 0; k < check.size(); k++) {
+    FUZZ_CHECK(check[k] == 0xA5A5A5A5u);
+  }
+  FUZZ_CHECK(checked == (inRange && checkWords >= 5 ? 1 : 0));
+  if (checked) {
+    uint32_t filled = 0;
+    bool repeated = false;
+    for (int i = 0; i < 81; i++) {
+      filled += values[i] ? 1u : 0u;
+      for (int j = 0; j < i; j++) {
+        repeated = repeated || (values[i] != 0 && values[i] == values[j] && sameUnit(i, j));
+      }
+    }
+    FUZZ_CHECK(check[0] == filled);
+    FUZZ_CHECK(check[1] == (repeated ? 1u : 0u));
+    if (repeated) {
+      FUZZ_CHECK(check[2] < 27 && check[3] >= 1 && check[3] <= 9 && check[4] < 81);
+      FUZZ_CHECK(values[check[4]] == check[3]);
+    }
+  }
+
+  // recalc_candidates: a solved cell keeps its digit, an empty one what its peers leave
+  uint16_t recalc[81];
+  std::memcpy(recalc, cands, sizeof(recalc));
+  FUZZ_CHECK(sudorix_solver_recalc_candidates(values, recalc) == (inRange ? 1 : 0));
+  if (inRange) {
+    for (int i = 0; i < 81; i++) {
+      uint16_t expected = 0x1FFu;
+      for (int j = 0; j < 81; j++) {
+        if (j != i && values[j] != 0 && sameUnit(i, j)) {
+          expected &= (uint16_t)~(1u << (values[j] - 1));
+        }
+      }
+      FUZZ_CHECK(recalc[i] == (values[i] ? (uint16_t)(1u << (values[i] - 1)) : expected));
+    }
+  } else {
+    FUZZ_CHECK(std::memcmp(recalc, cands, sizeof(recalc)) == 0);
+  }
+
+  // clear_peers: only the digit, only in unsolved peers
+  uint16_t cleared[81];
+  std::memcpy(cleared, cands, sizeof(cleared));
+  const bool validArgs = peerIdx < 81 && peerDigit >= 1 && peerDigit <= 9;
+  FUZZ_CHECK(sudorix_solver_clear_peers(values, cleared, peerIdx, peerDigit) == (validArgs ? 1 : 0));
+  for (int i = 0; i < 81; i++) {
+    const bool peer = validArgs && i != (int)peerIdx && values[i] == 0 && sameUnit(i, (int)peerIdx);
+    FUZZ_CHECK(cleared[i] == (peer ? (uint16_t)(cands[i] & ~(1u << (peerDigit - 1))) : cands[i]));
+  }
+
+  // load_board: any in-range board is accepted and can be stepped
+  FUZZ_CHECK(sudorix_solver_load_board(values, cands) == (inRange ? 1 : 0));
+  if (inRange) {
+    std::vector<uint32_t> out(1024);
+    for (int k = 0; k < steps && sudorix_solver_next_step(out.data(), 1024); k++) {
+      fuzzCheckEvent(out.data(), 1024);
+    }
+    uint8_t values2[81];
+    uint16_t cands2[81];
+    FUZZ_CHECK(sudorix_solver_export_board(values2, cands2) == 1);
+  }
+  return 0;
+}
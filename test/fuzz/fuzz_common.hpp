@@ -0,0 +1,56 @@
+#ifndef FUZZ_COMMON_H
+#define FUZZ_COMMON_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Shared helpers for the libFuzzer harnesses (one per C API entry point group).
+// Every harness defines LLVMFuzzerTestOneInput; build with -fsanitize=fuzzer
+// (clang) or link standalone_main.cpp to replay a corpus with any compiler.
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size);
+
+// Abort (so the fuzzer records a crash) when an invariant of the C API is broken.
+#define FUZZ_CHECK(cond) \
+  do { \
+    if (!(cond)) { \
+      __builtin_trap(); \
+    } \
+  } while (0)
+
+// Splits the input at the first '\n': the text part is returned NUL-terminated,
+// the remaining bytes are control bytes for the harness.
+inline std::string fuzzSplitText(const uint8_t *data, size_t size, const uint8_t **rest, size_t *restSize) {
+  size_t n = 0;
+  while (n < size && data[n] != '\n') {
+    n++;
+  }
+  *rest = (n < size) ? data + n + 1 : data + size;
+  *restSize = (n < size) ? size - n - 1 : 0;
+  std::string text(reinterpret_cast<const char *>(data), n);
+  // embedded NULs would only shorten the C string, keep them out of the way
+  for (char &c : text) {
+    if (c == '\0') {
+      c = ' ';
+    }
+  }
+  return text;
+}
+
+// Capacity of the out[] buffer: taken from the control bytes, 1024 by default.
+inline uint32_t fuzzOutWords(const uint8_t *rest, size_t restSize) {
+  return restSize > 0 ? (uint32_t)rest[0] * 4u : 1024u;
+}
+
+// An event written in out[] layout must be well formed.
+inline void fuzzCheckEvent(const uint32_t *out, uint32_t outWords) {
+  FUZZ_CHECK(out[0] == 1 || out[0] == 2);
+  FUZZ_CHECK(out[3] > 0 && out[3] <= (outWords - 4u) / 2u);
+  for (uint32_t k = 0; k < out[3]; k++) {
+    FUZZ_CHECK(out[4 + 2 * k + 0] < 81);
+    FUZZ_CHECK(out[4 + 2 * k + 1] >= 1 && out[4 + 2 * k + 1] <= 9);
+  }
+}
+
+#endif // FUZZ_COMMON_H
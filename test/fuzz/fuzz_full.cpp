@@ -0,0 +1,24 @@
+#include <cstdint>
+#include <cstring>
+
+#include "solver.hpp"
+#include "fuzz_common.hpp"
+
+// sudorix_solver_full: arbitrary text in, 81 symbols + NUL out (or an error).
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+  const uint8_t *rest = nullptr;
+  size_t restSize = 0;
+  const std::string in = fuzzSplitText(data, size, &rest, &restSize);
+
+  char out81[82];
+  std::memset(out81, 0x7F, sizeof(out81));
+  if (!sudorix_solver_full(in.c_str(), out81)) {
+    return 0;
+  }
+
+  FUZZ_CHECK(out81[81] == '\0');
+  for (int i = 0; i < 81; i++) {
+    FUZZ_CHECK(out81[i] == '.' || (out81[i] >= '1' && out81[i] <= '9'));
+  }
+  return 0;
+}
@@ -0,0 +1,53 @@
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "solver.hpp"
+#include "fuzz_common.hpp"
+
+// sudorix_solver_full_batch against sudorix_solver_full, puzzle by puzzle.
+// The text part is cut into 81-byte puzzles (a trailing partial one is dropped); every
+// pair of control bytes (cell, symbol) adds a copy of the first puzzle with that cell
+// changed, so a puzzle line from the test files is a valid seed that also grows
+// conflicting, contradictory and unsolvable variants in several lanes.
+// Every output slot must be the output of sudorix_solver_full, or 81 '.' where that
+// rejects the puzzle, and nothing may be written past the last slot.
+static constexpr size_t MAX_PUZZLES = 40;  // more than two batches of lanes
+static constexpr size_t GUARD = 16;
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+  const uint8_t *rest = nullptr;
+  size_t restSize = 0;
+  const std::string text = fuzzSplitText(data, size, &rest, &restSize);
+
+  std::string in;
+  for (size_t p = 0; p + 81 <= text.size() && in.size() < MAX_PUZZLES * 81; p += 81) {
+    in.append(text, p, 81);
+  }
+  if (in.empty()) {
+    return 0;
+  }
+  for (size_t k = 0; k + 1 < restSize && in.size() < MAX_PUZZLES * 81; k += 2) {
+    std::string variant = in.substr(0, 81);
+    variant[rest[k] % 81] = (char)('0' + rest[k + 1] % 10);
+    in += variant;
+  }
+  const uint32_t count = (uint32_t)(in.size() / 81);
+
+  std::vector<char> out(in.size() + GUARD, 0x7F);
+  FUZZ_CHECK(sudorix_solver_full_batch(in.data(), out.data(), count) == 1);
+  for (size_t k = in.size(); k < out.size(); k++) {
+    FUZZ_CHECK(out[k] == 0x7F);
+  }
+
+  for (uint32_t n = 0; n < count; n++) {
+    const std::string puzzle = in.substr((size_t)n * 81, 81);
+    char expected[82];
+    if (!sudorix_solver_full(puzzle.c_str(), expected)) {
+      std::memset(expected, '.', 81);
+    }
+    FUZZ_CHECK(std::memcmp(out.data() + (size_t)n * 81, expected, 81) == 0);
+  }
+  return 0;
+}
@@ -0,0 +1,57 @@
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "solver.hpp"
+#include "SudokuBoard.hpp"
+#include "fuzz_common.hpp"
+
+// sudorix_solver_hint on caller-owned buffers.
+// Input: 81 value bytes ('1'..'9' -> digit, '0'/'.' -> empty, any other byte passed
+// through raw), optional '\n', then up to 162 bytes XORed into the candidate masks
+// derived from the values, then one byte for the out[] capacity / 4.
+// Puzzle lines from the test files are therefore valid seeds.
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+  if (size < 81) {
+    return 0;
+  }
+
+  uint8_t values[81];
+  for (int i = 0; i < 81; i++) {
+    const uint8_t b = data[i];
+    if (b >= '1' && b <= '9') {
+      values[i] = (uint8_t)(b - '0');
+    } else if (b == '0' || b == '.') {
+      values[i] = 0;
+    } else {
+      values[i] = b;
+    }
+  }
+
+  uint16_t cands[81];
+  std::memset(cands, 0, sizeof(cands));
+  uint8_t clean[81];
+  for (int i = 0; i < 81; i++) {
+    clean[i] = values[i] <= 9 ? values[i] : 0;
+  }
+  SudokuBoard board;
+  board.importFromBuffers(clean, cands);
+  board.recalcAllCandidatesFromValues();
+  board.exportToBuffers(clean, cands);
+
+  size_t pos = 81;
+  if (pos < size && data[pos] == '\n') {
+    pos++;
+  }
+  uint8_t *candBytes = reinterpret_cast<uint8_t *>(cands);
+  for (size_t k = 0; k < sizeof(cands) && pos < size; k++, pos++) {
+    candBytes[k] ^= data[pos];
+  }
+  const uint32_t outWords = fuzzOutWords(data + pos, size - pos);
+
+  std::vector<uint32_t> out(outWords + 1u);
+  if (sudorix_solver_hint(values, cands, out.data(), outWords)) {
+    fuzzCheckEvent(out.data(), outWords);
+  }
+  return 0;
+}
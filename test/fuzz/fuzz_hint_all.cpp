@@ -0,0 +1,113 @@
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "solver.hpp"
+#include "SudokuBoard.hpp"
+#include "fuzz_common.hpp"
+
+// sudorix_solver_hint_best + sudorix_solver_hint_all on caller-owned buffers.
+// Input: as for fuzz_hint (81 value bytes, optional '\n', up to 162 bytes XORed into the
+// candidate masks derived from the values), then control bytes: out_words (raw, so the
+// truncation of hint_all is reached), technique bits, max tier, lookahead in us.
+// Nothing may be written past out_words; the records of hint_all must be well formed and
+// a prefix of what an unbounded buffer receives, stopping only where the next one does
+// not fit.
+static constexpr uint32_t GUARD = 8;
+static constexpr uint32_t SENTINEL = 0xA5A5A5A5u;
+static constexpr uint32_t BIG_WORDS = 1u << 16;
+
+static void checkGuard(const std::vector<uint32_t> &out, uint32_t outWords) {
+  for (size_t k = outWords; k < out.size(); k++) {
+    FUZZ_CHECK(out[k] == SENTINEL);
+  }
+}
+
+// Checks the 'n' records at the start of out[] and returns the words they use.
+static uint32_t walkRecords(const uint32_t *out, uint32_t outWords, int n) {
+  uint32_t used = 0;
+  for (int k = 0; k < n; k++) {
+    FUZZ_CHECK(used + 4 <= outWords);
+    fuzzCheckEvent(out + used, outWords - used);
+    FUZZ_CHECK(out[used + 2] == 0);
+    used += 4u + 2u * out[used + 3];
+  }
+  return used;
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+  if (size < 81) {
+    return 0;
+  }
+
+  uint8_t values[81];
+  bool inRange = true;
+  for (int i = 0; i < 81; i++) {
+    const uint8_t b = data[i];
+    if (b >= '1' && b <= '9') {
+      values[i] = (uint8_t)(b - '0');
+    } else if (b == '0' || b == '.') {
+      values[i] = 0;
+    } else {
+      values[i] = b;
+    }
+    inRange = inRange && values[i] <= 9;
+  }
+
+  uint16_t cands[81];
+  std::memset(cands, 0, sizeof(cands));
+  uint8_t clean[81];
+  for (int i = 0; i < 81; i++) {
+    clean[i] = values[i] <= 9 ? values[i] : 0;
+  }
+  SudokuBoard board;
+  board.importFromBuffers(clean, cands);
+  board.recalcAllCandidatesFromValues();
+  board.exportToBuffers(clean, cands);
+
+  size_t pos = 81;
+  if (pos < size && data[pos] == '\n') {
+    pos++;
+  }
+  uint8_t *candBytes = reinterpret_cast<uint8_t *>(cands);
+  for (size_t k = 0; k < sizeof(cands) && pos < size; k++, pos++) {
+    candBytes[k] ^= data[pos];
+  }
+  const uint8_t *ctl = data + pos;
+  const size_t ctlSize = size - pos;
+  const uint32_t outWords = ctlSize > 0 ? ctl[0] : 64;
+  const uint32_t techniques = ctlSize > 1 ? ctl[1] : SUDORIX_TECH_ALL;
+  const uint32_t maxTier = ctlSize > 2 ? ctl[2] % (SUDORIX_TIER_MAX + 2) : SUDORIX_TIER_ALL;
+  const uint32_t lookaheadUs = ctlSize > 3 ? ctl[3] : 100;
+
+  std::vector<uint32_t> out(outWords + GUARD, SENTINEL);
+  if (sudorix_solver_hint_best(values, cands, out.data(), outWords, maxTier, lookaheadUs)) {
+    fuzzCheckEvent(out.data(), outWords);
+  }
+  checkGuard(out, outWords);
+
+  std::fill(out.begin(), out.end(), SENTINEL);
+  uint32_t available = SENTINEL;
+  const int n = sudorix_solver_hint_all(values, cands, techniques, out.data(), outWords, &available);
+  checkGuard(out, outWords);
+  if (!inRange) {
+    FUZZ_CHECK(n == SUDORIX_INVALID_INPUT && available == 0);
+    return 0;
+  }
+  FUZZ_CHECK(n >= 0 && (uint32_t)n <= available);
+  const uint32_t used = walkRecords(out.data(), outWords, n);
+
+  std::vector<uint32_t> all(BIG_WORDS);
+  uint32_t availableAll = 0;
+  const int nAll = sudorix_solver_hint_all(values, cands, techniques, all.data(), BIG_WORDS, &availableAll);
+  FUZZ_CHECK(nAll >= n && availableAll == available);
+  if ((uint32_t)nAll < availableAll) {
+    return 0;  // even the big buffer is full: nothing more to compare
+  }
+  walkRecords(all.data(), BIG_WORDS, nAll);
+  FUZZ_CHECK(std::memcmp(out.data(), all.data(), used * sizeof(uint32_t)) == 0);
+  if (n < nAll) {
+    FUZZ_CHECK(used + 4u + 2u * all[used + 3] > outWords);
+  }
+  return 0;
+}
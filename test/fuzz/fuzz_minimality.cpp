@@ -0,0 +1,83 @@
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "solver.hpp"
+#include "fuzz_common.hpp"
+
+// sudorix_solver_minimality: arbitrary text in, solution count and redundant givens out.
+// Control byte: out_words (raw, so reports that do not fit are tried).
+// Nothing may be written past out_words, nor anywhere on failure; a call fails only for a
+// puzzle sudorix_solver_parse_board refuses or a report that does not fit. The report must
+// be consistent with the givens, and removing the first redundant given (or the first
+// necessary one) must keep (or lose) the unique solution.
+static constexpr uint32_t GUARD = 8;
+static constexpr uint32_t SENTINEL = 0xA5A5A5A5u;
+
+static uint32_t solutionsWithout(const uint8_t values[81], uint32_t cell) {
+  char in81[82];
+  for (int i = 0; i < 81; i++) {
+    in81[i] = values[i] && (uint32_t)i != cell ? (char)('0' + values[i]) : '.';
+  }
+  in81[81] = '\0';
+  std::vector<uint32_t> out(3u + 81u);
+  FUZZ_CHECK(sudorix_solver_minimality(in81, out.data(), (uint32_t)out.size()) == 1);
+  return out[0];
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+  const uint8_t *rest = nullptr;
+  size_t restSize = 0;
+  const std::string in = fuzzSplitText(data, size, &rest, &restSize);
+  const uint32_t outWords = restSize > 0 ? rest[0] : 3u + 81u;
+
+  std::vector<uint32_t> out(outWords + GUARD, SENTINEL);
+  const int checked = sudorix_solver_minimality(in.c_str(), out.data(), outWords);
+  FUZZ_CHECK(checked == 0 || checked == 1);
+  for (size_t k = checked ? outWords : 0; k < out.size(); k++) {
+    FUZZ_CHECK(out[k] == SENTINEL);
+  }
+
+  uint8_t values[81];
+  uint16_t cands[81];
+  const bool parsed = sudorix_solver_parse_board(in.c_str(), values, cands) == 1;
+  if (!checked) {
+    // refused: the puzzle is, or the report is too large for out_words
+    if (parsed && outWords >= 3u) {
+      std::vector<uint32_t> full(3u + 81u);
+      FUZZ_CHECK(sudorix_solver_minimality(in.c_str(), full.data(), (uint32_t)full.size()) == 1);
+      FUZZ_CHECK(3u + full[2] > outWords);
+    }
+    return 0;
+  }
+  FUZZ_CHECK(parsed);
+
+  uint32_t givens = 0;
+  for (int i = 0; i < 81; i++) {
+    givens += values[i] ? 1u : 0u;
+  }
+  FUZZ_CHECK(out[0] <= 2);
+  FUZZ_CHECK(out[1] == givens);
+  FUZZ_CHECK(out[2] <= givens && 3u + out[2] <= outWords);
+  FUZZ_CHECK(out[0] == 1 || out[2] == 0);
+
+  bool redundant[81] = {};
+  for (uint32_t k = 0; k < out[2]; k++) {
+    const uint32_t idx = out[3 + k];
+    FUZZ_CHECK(idx < 81 && values[idx] != 0 && !redundant[idx]);
+    redundant[idx] = true;
+  }
+  if (out[0] != 1) {
+    return 0;
+  }
+  if (out[2] > 0) {
+    FUZZ_CHECK(solutionsWithout(values, out[3]) == 1);
+  }
+  for (uint32_t i = 0; i < 81; i++) {
+    if (values[i] && !redundant[i]) {
+      FUZZ_CHECK(solutionsWithout(values, i) == 2);
+      break;
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,76 @@
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#include "solver.hpp"
+#include "fuzz_common.hpp"
+
+// sudorix_solver_parse_pencilmarks + sudorix_solver_format_pencilmarks.
+// Raw inputs are parsed as pencilmark text (both layouts; the whole input, since a
+// printed grid spans several lines). Inputs starting with a valid puzzle line are
+// stepped (first control byte = number of steps) and the board is formatted and
+// parsed instead, so puzzle lines from the test files are valid seeds.
+// Whatever parse accepts must format to a text that parses back to the same board; a
+// stepped board may only be refused if it is broken (a cell without candidates, a digit
+// repeated in a unit).
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+  const uint8_t *rest = nullptr;
+  size_t restSize = 0;
+  const std::string in = fuzzSplitText(data, size, &rest, &restSize);
+
+  uint8_t values[81];
+  uint16_t cands[81];
+  char text[730];
+  text[729] = '\0';
+  if (sudorix_solver_init_board(in.c_str())) {
+    uint32_t out[1024];
+    const int steps = restSize > 0 ? rest[0] : 30;
+    for (int k = 0; k < steps && sudorix_solver_next_step(out, 1024); k++) {
+    }
+    FUZZ_CHECK(sudorix_solver_export_board(values, cands) == 1);
+    FUZZ_CHECK(sudorix_solver_format_pencilmarks(values, cands, text) == 1);
+    if (!sudorix_solver_parse_pencilmarks(text, values, cands)) {
+      // an unsolvable puzzle can be stepped into a broken board, which parse refuses: a cell
+      // without candidates, or a digit repeated once the single-candidate cells are placed
+      FUZZ_CHECK(sudorix_solver_export_board(values, cands) == 1);
+      bool broken = false;
+      for (int i = 0; i < 81; i++) {
+        broken = broken || (values[i] == 0 && cands[i] == 0);
+        if (values[i] == 0 && cands[i] != 0 && (cands[i] & (cands[i] - 1)) == 0) {
+          values[i] = (uint8_t)(__builtin_ctz(cands[i]) + 1);
+        }
+      }
+      uint32_t check[5];
+      FUZZ_CHECK(sudorix_solver_check_grid(values, check, 5) == 1);
+      FUZZ_CHECK(broken || check[1] != 0);
+      return 0;
+    }
+  } else {
+    std::string raw(reinterpret_cast<const char *>(data), size);
+    for (char &c : raw) {
+      if (c == '\0') {
+        c = ' ';
+      }
+    }
+    if (!sudorix_solver_parse_pencilmarks(raw.c_str(), values, cands)) {
+      return 0;
+    }
+  }
+
+  for (int i = 0; i < 81; i++) {
+    FUZZ_CHECK(values[i] <= 9);
+    FUZZ_CHECK(cands[i] != 0 && (cands[i] & ~0x1FFu) == 0);
+    const bool single = (cands[i] & (cands[i] - 1)) == 0;
+    FUZZ_CHECK(single == (values[i] != 0));
+  }
+
+  char again[730];
+  again[729] = '\0';
+  uint8_t values2[81];
+  uint16_t cands2[81];
+  FUZZ_CHECK(sudorix_solver_format_pencilmarks(values, cands, again) == 1);
+  FUZZ_CHECK(sudorix_solver_parse_pencilmarks(again, values2, cands2) == 1);
+  FUZZ_CHECK(std::memcmp(values, values2, sizeof(values)) == 0);
+  FUZZ_CHECK(std::memcmp(cands, cands2, sizeof(cands)) == 0);
+  return 0;
+}
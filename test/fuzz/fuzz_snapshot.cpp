@@ -0,0 +1,48 @@
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "solver.hpp"
+#include "fuzz_common.hpp"
+
+// sudorix_solver_snapshot + sudorix_solver_restore.
+// Raw inputs are fed to restore as blobs. Inputs starting with a valid puzzle line are
+// stepped (first control byte = number of steps), snapshotted and restored instead,
+// so puzzle lines from the test files are valid seeds.
+// Whatever restore accepts must snapshot back to the same bytes.
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+  const uint8_t *rest = nullptr;
+  size_t restSize = 0;
+  const std::string in = fuzzSplitText(data, size, &rest, &restSize);
+
+  std::vector<uint8_t> blob;
+  if (sudorix_solver_init_board(in.c_str())) {
+    uint32_t out[1024];
+    const int steps = restSize > 0 ? rest[0] : 30;
+    for (int k = 0; k < steps && sudorix_solver_next_step(out, 1024); k++) {
+    }
+    const int n = sudorix_solver_snapshot(nullptr, 0);
+    FUZZ_CHECK(n > 0);
+    blob.resize((size_t)n);
+    FUZZ_CHECK(sudorix_solver_snapshot(blob.data(), (uint32_t)n) == n);
+    FUZZ_CHECK(sudorix_solver_restore(blob.data(), (uint32_t)n) == 1);
+  } else {
+    blob.assign(data, data + size);
+    if (!sudorix_solver_restore(blob.data(), (uint32_t)blob.size())) {
+      return 0;
+    }
+  }
+
+  const int n = sudorix_solver_snapshot(nullptr, 0);
+  FUZZ_CHECK(n == (int)blob.size());
+  std::vector<uint8_t> again((size_t)n);
+  FUZZ_CHECK(sudorix_solver_snapshot(again.data(), (uint32_t)n) == n);
+  FUZZ_CHECK(std::memcmp(again.data(), blob.data(), blob.size()) == 0);
+
+  // the restored session must keep working
+  uint32_t out[1024];
+  for (int k = 0; k < 100 && sudorix_solver_next_step(out, 1024); k++) {
+    fuzzCheckEvent(out, 1024);
+  }
+  return 0;
+}
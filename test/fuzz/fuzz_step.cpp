@@ -0,0 +1,35 @@
+#include <cstdint>
+#include <vector>
+
+#include "solver.hpp"
+#include "fuzz_common.hpp"
+
+// sudorix_solver_init_board + sudorix_solver_next_step + sudorix_solver_export_board.
+// Text line = puzzle, first control byte = out[] capacity / 4.
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+  const uint8_t *rest = nullptr;
+  size_t restSize = 0;
+  const std::string in = fuzzSplitText(data, size, &rest, &restSize);
+  const uint32_t outWords = fuzzOutWords(rest, restSize);
+
+  if (!sudorix_solver_init_board(in.c_str())) {
+    return 0;
+  }
+
+  std::vector<uint32_t> out(outWords + 1u);
+  for (int step = 0; step < 1000; step++) {
+    if (!sudorix_solver_next_step(out.data(), outWords)) {
+      break;
+    }
+    fuzzCheckEvent(out.data(), outWords);
+  }
+
+  uint8_t values[81];
+  uint16_t cands[81];
+  FUZZ_CHECK(sudorix_solver_export_board(values, cands) == 1);
+  for (int i = 0; i < 81; i++) {
+    FUZZ_CHECK(values[i] <= 9);
+    FUZZ_CHECK(cands[i] <= 0x1FFu);
+  }
+  return 0;
+}
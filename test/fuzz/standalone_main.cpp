@@ -0,0 +1,67 @@
+#include <cstdint>
+#include <cstdio>
+
+#include <dirent.h>
+#include <sys/stat.h>
+
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "fuzz_common.hpp"
+
+// Replays corpus files (or every file in corpus directories) through a harness,
+// for toolchains without libFuzzer. Typically built with -fsanitize=address,undefined.
+
+static size_t runFile(const std::string &path) {
+  std::ifstream in(path, std::ios::binary);
+  if (!in) {
+    std::cerr << "Failed to open: " << path << "\n";
+    return 0;
+  }
+  std::vector<uint8_t> data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+  LLVMFuzzerTestOneInput(data.data(), data.size());
+  return 1;
+}
+
+static size_t runPath(const std::string &path) {
+  struct stat st;
+  if (stat(path.c_str(), &st) != 0) {
+    std::cerr << "No such file or directory: " << path << "\n";
+    return 0;
+  }
+  if (!S_ISDIR(st.st_mode)) {
+    return runFile(path);
+  }
+
+  size_t n = 0;
+  DIR *dir = opendir(path.c_str());
+  if (!dir) {
+    return 0;
+  }
+  while (struct dirent *e = readdir(dir)) {
+    const std::string name = e->d_name;
+    if (name == "." || name == "..") {
+      continue;
+    }
+    n += runPath(path + "/" + name);
+  }
+  closedir(dir);
+  return n;
+}
+
+int main(int argc, char **argv) {
+  if (argc < 2) {
+    std::cerr << "Usage: " << argv[0] << " <corpus file or dir>...\n";
+    return 2;
+  }
+
+  size_t n = 0;
+  for (int i = 1; i < argc; i++) {
+    n += runPath(argv[i]);
+  }
+  std::cout << "Executed " << n << " inputs\n";
+  return 0;
+}
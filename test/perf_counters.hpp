@@ -0,0 +1,141 @@
+#ifndef PERF_COUNTERS_H
+#define PERF_COUNTERS_H
+
+#include <cstdint>
+#include <cstring>
+
+#if defined(__linux__)
+  #include <linux/perf_event.h>
+  #include <sys/ioctl.h>
+  #include <sys/syscall.h>
+  #include <unistd.h>
+#endif
+
+// Hardware performance counters for the calling thread (Linux perf_event_open).
+//
+// Each counter is opened on its own, so a machine (or VM, or container) that
+// exposes only some of them still reports those. Counters that cannot be
+// opened read as unavailable; on non-Linux builds all of them are.
+class PerfCounters
+{
+public:
+  enum Counter {
+    Cycles = 0,
+    Instructions,
+    BranchMisses,
+    L1dMisses,
+    NumCounters
+  };
+
+  struct Sample {
+    uint64_t value[NumCounters];
+    bool valid[NumCounters];
+  };
+
+  PerfCounters() {
+    for (int i = 0; i < NumCounters; i++) {
+      fds[i] = -1;
+    }
+  }
+
+  ~PerfCounters() {
+    close();
+  }
+
+  PerfCounters(const PerfCounters &) = delete;
+  PerfCounters &operator=(const PerfCounters &) = delete;
+
+  // Returns the number of counters that could be opened (0 = fall back to wall-clock only).
+  int open() {
+    int opened = 0;
+#if defined(__linux__)
+    const uint32_t types[NumCounters] = {
+      PERF_TYPE_HARDWARE,
+      PERF_TYPE_HARDWARE,
+      PERF_TYPE_HARDWARE,
+      PERF_TYPE_HW_CACHE
+    };
+    const uint64_t configs[NumCounters] = {
+      PERF_COUNT_HW_CPU_CYCLES,
+      PERF_COUNT_HW_INSTRUCTIONS,
+      PERF_COUNT_HW_BRANCH_MISSES,
+      PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)
+    };
+    for (int i = 0; i < NumCounters; i++) {
+      struct perf_event_attr attr;
+      std::memset(&attr, 0, sizeof(attr));
+      attr.size = sizeof(attr);
+      attr.type = types[i];
+      attr.config = configs[i];
+      attr.disabled = 1;
+      attr.exclude_kernel = 1;
+      attr.exclude_hv = 1;
+      fds[i] = (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+      if (fds[i] >= 0) {
+        opened++;
+      }
+    }
+#endif
+    return opened;
+  }
+
+  void close() {
+#if defined(__linux__)
+    for (int i = 0; i < NumCounters; i++) {
+      if (fds[i] >= 0) {
+        ::close(fds[i]);
+        fds[i] = -1;
+      }
+    }
+#endif
+  }
+
+  bool available() const {
+    for (int i = 0; i < NumCounters; i++) {
+      if (fds[i] >= 0) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void start() {
+#if defined(__linux__)
+    for (int i = 0; i < NumCounters; i++) {
+      if (fds[i] >= 0) {
+        ioctl(fds[i], PERF_EVENT_IOC_RESET, 0);
+        ioctl(fds[i], PERF_EVENT_IOC_ENABLE, 0);
+      }
+    }
+#endif
+  }
+
+  Sample stop() {
+    Sample s;
+    for (int i = 0; i < NumCounters; i++) {
+      s.value[i] = 0;
+      s.valid[i] = false;
+#if defined(__linux__)
+      if (fds[i] >= 0) {
+        ioctl(fds[i], PERF_EVENT_IOC_DISABLE, 0);
+        uint64_t v = 0;
+        if (read(fds[i], &v, sizeof(v)) == (ssize_t)sizeof(v)) {
+          s.value[i] = v;
+          s.valid[i] = true;
+        }
+      }
+#endif
+    }
+    return s;
+  }
+
+  static const char *name(int counter) {
+    static const char *const names[NumCounters] = { "cycles", "instr", "br-miss", "L1d-miss" };
+    return names[counter];
+  }
+
+private:
+  int fds[NumCounters];
+};
+
+#endif // PERF_COUNTERS_H
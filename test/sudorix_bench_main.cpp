@@ -0,0 +1,449 @@
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "solver.hpp"
+#include "techniques.hpp"
+#include "SudokuBoard.hpp"
+#include "BoardAnalysis.hpp"
+#include "perf_counters.hpp"
+
+// Microbenchmarks for the solver building blocks.
+//
+// Fixed board states are captured mid-solve: every puzzle is stepped with
+// sudorix_solver_next_step and the board is exported every --stride steps.
+// Each benchmark then runs once over all captured states per repetition;
+// ns/op is reported as mean, standard deviation and minimum across repetitions.
+//
+// With --perf, hardware counters (cycles, instructions, branch misses, L1d misses)
+// are read per benchmark and per puzzle through perf_event_open. Counters the
+// machine does not expose are reported as n/a and wall-clock timing goes on.
+
+// A board state captured while solving.
+struct BoardState {
+  char str[82];      // values only, '.' for empty
+  uint8_t values[81];
+  uint16_t cands[81];
+  SudokuBoard board;
+};
+
+// Prevents the compiler from discarding benchmark results.
+static volatile uint64_t g_sink = 0;
+
+// A line holds either a puzzle (81 symbols) or a mid-solve board in the fixed
+// pencilmark layout (729 symbols).
+static bool loadPuzzle(const std::string &line, std::string *in81) {
+  std::string compact;
+  for (char c : line) {
+    if (c == '.' || (c >= '0' && c <= '9')) {
+      compact.push_back(c);
+    } else if (c == '#') {
+      break;
+    }
+  }
+  if (compact.size() != 81 && compact.size() != SudokuBoard::PENCILMARKS_SIZE) {
+    return false;
+  }
+  *in81 = compact;
+  return true;
+}
+
+static void fillState(BoardState &st) {
+  st.board.exportToBuffers(st.values, st.cands);
+  for (int i = 0; i < 81; i++) {
+    st.str[i] = st.values[i] ? (char)('0' + st.values[i]) : '.';
+  }
+  st.str[81] = '\0';
+}
+
+// A pencilmark board is benchmarked as given, and its placed values stand for the
+// puzzle in the whole-puzzle benchmarks.
+static bool capturePencilmarks(const std::string &text, std::vector<BoardState> &states, std::string *in81) {
+  BoardState st;
+  if (!st.board.importFromPencilmarks(text.c_str())) {
+    return false;
+  }
+  fillState(st);
+  states.push_back(st);
+  *in81 = st.str;
+  return true;
+}
+
+static void captureStates(const std::string &in81, size_t stride, std::vector<BoardState> &states) {
+  if (!sudorix_solver_init_board(in81.c_str())) {
+    return;
+  }
+
+  uint32_t ev[1024];
+  size_t step = 0;
+  while (true) {
+    if (step % stride == 0) {
+      BoardState st;
+      sudorix_solver_export_board(st.values, st.cands);
+      st.board.importFromBuffers(st.values, st.cands);
+      fillState(st);
+      states.push_back(st);
+    }
+    if (!sudorix_solver_next_step(ev, 1024)) {
+      break;
+    }
+    step++;
+  }
+}
+
+struct BenchResult {
+  double mean;
+  double stddev;
+  double min;
+  PerfCounters::Sample counters;  // summed over all timed repetitions
+  uint64_t ops;                   // number of timed operations
+};
+
+// Runs fn over every state 'reps' times (after one warm-up pass) and returns ns/op statistics.
+// Each call of fn counts as 'opsPerState' operations.
+// If perf is given, its counters cover all timed repetitions.
+template <typename State, typename Fn>
+static BenchResult runBench(std::vector<State> &states, int reps, PerfCounters *perf, Fn fn,
+                            size_t opsPerState = 1) {
+  uint64_t warm = 0;
+  for (State &st : states) {
+    warm += (uint64_t)fn(st);
+  }
+  g_sink = g_sink + warm;
+
+  std::vector<double> samples;
+  samples.reserve((size_t)reps);
+  if (perf) {
+    perf->start();
+  }
+  for (int rep = 0; rep < reps; rep++) {
+    uint64_t acc = 0;
+    const auto t0 = std::chrono::steady_clock::now();
+    for (State &st : states) {
+      acc += (uint64_t)fn(st);
+    }
+    const auto t1 = std::chrono::steady_clock::now();
+    g_sink = g_sink + acc;
+    const double ns = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count();
+    samples.push_back(ns / (double)(states.size() * opsPerState));
+  }
+
+  BenchResult r;
+  r.mean = 0.0;
+  r.stddev = 0.0;
+  r.min = 0.0;
+  r.ops = (uint64_t)reps * states.size() * opsPerState;
+  if (perf) {
+    r.counters = perf->stop();
+  } else {
+    std::memset(&r.counters, 0, sizeof(r.counters));
+  }
+  for (double v : samples) {
+    r.mean += v;
+  }
+  r.mean /= (double)samples.size();
+  for (double v : samples) {
+    r.stddev += (v - r.mean) * (v - r.mean);
+  }
+  r.stddev = samples.size() > 1 ? std::sqrt(r.stddev / (double)(samples.size() - 1)) : 0.0;
+  r.min = *std::min_element(samples.begin(), samples.end());
+  return r;
+}
+
+// Counter columns: per-op values of each counter, then IPC.
+static void printCounterHeader() {
+  for (int c = 0; c < PerfCounters::NumCounters; c++) {
+    std::cout << std::setw(12) << PerfCounters::name(c);
+  }
+  std::cout << std::setw(7) << "IPC";
+}
+
+static void printCounters(const PerfCounters::Sample &s, uint64_t ops) {
+  std::cout << std::fixed << std::setprecision(1);
+  for (int c = 0; c < PerfCounters::NumCounters; c++) {
+    if (s.valid[c]) {
+      std::cout << std::setw(12) << (double)s.value[c] / (double)std::max<uint64_t>(1, ops);
+    } else {
+      std::cout << std::setw(12) << "n/a";
+    }
+  }
+  const bool ipc = s.valid[PerfCounters::Cycles] && s.valid[PerfCounters::Instructions] &&
+                   s.value[PerfCounters::Cycles] > 0;
+  if (ipc) {
+    std::cout << std::setw(7) << std::setprecision(2)
+              << (double)s.value[PerfCounters::Instructions] / (double)s.value[PerfCounters::Cycles];
+  } else {
+    std::cout << std::setw(7) << "n/a";
+  }
+}
+
+static void printHeader(bool perf) {
+  std::cout << std::left << std::setw(32) << "Benchmark"
+            << std::right << std::setw(12) << "ns/op"
+            << std::setw(12) << "stddev"
+            << std::setw(9) << "cv"
+            << std::setw(12) << "min";
+  if (perf) {
+    printCounterHeader();
+  }
+  std::cout << "\n" << std::string(perf ? 132 : 77, '-') << "\n";
+}
+
+static void printResult(const std::string &name, const BenchResult &r, bool perf) {
+  std::cout << std::left << std::setw(32) << name
+            << std::right << std::fixed << std::setprecision(1)
+            << std::setw(12) << r.mean
+            << std::setw(12) << r.stddev
+            << std::setw(8) << (r.mean > 0.0 ? 100.0 * r.stddev / r.mean : 0.0) << "%"
+            << std::setw(12) << r.min;
+  if (perf) {
+    printCounters(r.counters, r.ops);
+  }
+  std::cout << "\n";
+}
+
+// One full solve per puzzle under the counters.
+static void runPerfPuzzles(const std::vector<std::string> &puzzles, PerfCounters &perf) {
+  std::cout << "\n" << std::left << std::setw(8) << "Puzzle"
+            << std::right << std::setw(12) << "ns"
+            << std::setw(8) << "solved";
+  printCounterHeader();
+  std::cout << "\n" << std::string(95, '-') << "\n";
+
+  char out81[82];
+  for (size_t i = 0; i < puzzles.size(); i++) {
+    perf.start();
+    const auto t0 = std::chrono::steady_clock::now();
+    sudorix_solver_full(puzzles[i].c_str(), out81);
+    const auto t1 = std::chrono::steady_clock::now();
+    const PerfCounters::Sample s = perf.stop();
+    const bool solved = std::strchr(out81, '.') == nullptr;
+    std::cout << std::left << std::setw(8) << (i + 1)
+              << std::right << std::setw(12)
+              << std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count()
+              << std::setw(8) << (solved ? "yes" : "no");
+    printCounters(s, 1);
+    std::cout << "\n";
+  }
+}
+
+static void usage(const char *argv0) {
+  std::cerr
+      << "Usage: " << argv0 << " <sudoku_file.txt> [--puzzles=N] [--stride=S] [--reps=R] [--filter=TEXT]\n"
+      << "         [--batch=B] [--perf] [--perf-puzzles]\n"
+      << "  Lines hold puzzles (81 symbols) or boards in the 729-character pencilmark layout,\n"
+      << "  which are benchmarked as given instead of being stepped through.\n"
+      << "  --puzzles=N   number of puzzles to capture states from (default 200)\n"
+      << "  --stride=S    capture one board state every S solver steps (default 8)\n"
+      << "  --reps=R      timed repetitions per benchmark (default 20)\n"
+      << "  --filter=TEXT run only benchmarks whose name contains TEXT\n"
+      << "  --batch=B     puzzles per sudorix_solver_full_batch call (default 256)\n"
+      << "  --perf        read hardware counters per benchmark (Linux perf_event_open)\n"
+      << "  --perf-puzzles  as --perf, and also time a full solve of every puzzle under the counters\n";
+}
+
+int main(int argc, char **argv) {
+  if (argc < 2) {
+    usage(argv[0]);
+    return 2;
+  }
+
+  std::string path = argv[1];
+  size_t maxPuzzles = 200;
+  size_t stride = 8;
+  int reps = 20;
+  std::string filter;
+  bool perfEnabled = false;
+  bool perfPuzzles = false;
+  size_t batchSize = 256;
+  for (int i = 2; i < argc; i++) {
+    std::string a = argv[i];
+    if (a.rfind("--puzzles=", 0) == 0) {
+      maxPuzzles = (size_t)std::strtoul(a.c_str() + std::strlen("--puzzles="), nullptr, 10);
+    } else if (a.rfind("--stride=", 0) == 0) {
+      stride = std::max<size_t>(1, (size_t)std::strtoul(a.c_str() + std::strlen("--stride="), nullptr, 10));
+    } else if (a.rfind("--reps=", 0) == 0) {
+      reps = std::max(2, std::atoi(a.c_str() + std::strlen("--reps=")));
+    } else if (a.rfind("--filter=", 0) == 0) {
+      filter = a.substr(std::strlen("--filter="));
+    } else if (a.rfind("--batch=", 0) == 0) {
+      batchSize = std::max<size_t>(1, (size_t)std::strtoul(a.c_str() + std::strlen("--batch="), nullptr, 10));
+    } else if (a == "--perf") {
+      perfEnabled = true;
+    } else if (a == "--perf-puzzles") {
+      perfEnabled = true;
+      perfPuzzles = true;
+    } else {
+      std::cerr << "Unknown option: " << a << "\n";
+      usage(argv[0]);
+      return 2;
+    }
+  }
+
+  std::ifstream fin(path);
+  if (!fin) {
+    std::cerr << "Failed to open file: " << path << "\n";
+    return 2;
+  }
+
+  std::vector<BoardState> states;
+  std::vector<std::string> puzzles;
+  std::string line;
+  while (puzzles.size() < maxPuzzles && std::getline(fin, line)) {
+    std::string in81;
+    if (!loadPuzzle(line, &in81)) {
+      continue;
+    }
+    if (in81.size() == SudokuBoard::PENCILMARKS_SIZE) {
+      if (!capturePencilmarks(in81, states, &in81)) {
+        std::cerr << "Invalid pencilmark board skipped\n";
+        continue;
+      }
+    } else {
+      captureStates(in81, stride, states);
+    }
+    puzzles.push_back(in81);
+  }
+
+  if (states.empty()) {
+    std::cerr << "No board states captured from: " << path << "\n";
+    return 2;
+  }
+
+  PerfCounters counters;
+  PerfCounters *perf = nullptr;
+  if (perfEnabled) {
+    const int opened = counters.open();
+    if (opened == 0) {
+      std::cerr << "perf_event_open: no hardware counters available, reporting wall-clock only\n";
+    } else {
+      if (opened < PerfCounters::NumCounters) {
+        std::cerr << "perf_event_open: only " << opened << " of " << PerfCounters::NumCounters
+                  << " counters available\n";
+      }
+      perf = &counters;
+    }
+  }
+  const bool showPerf = perf != nullptr;
+
+  std::cout << "States: " << states.size() << " (from " << puzzles.size() << " puzzles, stride " << stride
+            << "), reps: " << reps << "\n\n";
+  printHeader(showPerf);
+
+  auto selected = [&](const std::string &name) {
+    return filter.empty() || name.find(filter) != std::string::npos;
+  };
+
+  if (selected("importFromString")) {
+    SudokuBoard board;
+    printResult("importFromString", runBench(states, reps, perf, [&](BoardState &st) {
+      return board.importFromString(st.str);
+    }), showPerf);
+  }
+
+  if (selected("importFromBuffers")) {
+    SudokuBoard board;
+    printResult("importFromBuffers", runBench(states, reps, perf, [&](BoardState &st) {
+      return board.importFromBuffers(st.values, st.cands);
+    }), showPerf);
+  }
+
+  if (selected("exportToBuffers")) {
+    uint8_t values[81];
+    uint16_t cands[81];
+    printResult("exportToBuffers", runBench(states, reps, perf, [&](BoardState &st) {
+      st.board.exportToBuffers(values, cands);
+      return values[0] + cands[80];
+    }), showPerf);
+  }
+
+  if (selected("importFromPencilmarks")) {
+    std::vector<std::string> texts(states.size(), std::string(SudokuBoard::PENCILMARKS_SIZE, '.'));
+    for (size_t k = 0; k < states.size(); k++) {
+      states[k].board.exportToPencilmarks(&texts[k][0]);
+    }
+    SudokuBoard board;
+    printResult("importFromPencilmarks", runBench(texts, reps, perf, [&](std::string &text) {
+      return board.importFromPencilmarks(text.c_str());
+    }), showPerf);
+  }
+
+  if (selected("exportToPencilmarks")) {
+    char text[SudokuBoard::PENCILMARKS_SIZE];
+    printResult("exportToPencilmarks", runBench(states, reps, perf, [&](BoardState &st) {
+      st.board.exportToPencilmarks(text);
+      return text[0] + text[728];
+    }), showPerf);
+  }
+
+  if (selected("recalcAllCandidatesFromValues")) {
+    std::vector<BoardState> work = states;
+    printResult("recalcAllCandidatesFromValues", runBench(work, reps, perf, [&](BoardState &st) {
+      return st.board.recalcAllCandidatesFromValues();
+    }), showPerf);
+  }
+
+  // A pass builds one BoardAnalysis shared by its techniques: time the build on its own,
+  // and the techniques on analyses built beforehand (by the warm-up pass).
+  if (selected("BoardAnalysis")) {
+    printResult("BoardAnalysis", runBench(states, reps, perf, [&](BoardState &st) {
+      BoardAnalysis analysis(st.board);
+      return analysis.candidateCount(0);
+    }), showPerf);
+  }
+
+  std::vector<BoardAnalysis> analyses;
+  analyses.reserve(states.size());
+  for (BoardState &st : states) {
+    analyses.emplace_back(st.board);
+  }
+  for (size_t t = 0; t < sudorix_technique_count(); t++) {
+    const std::string name = sudorix_technique_name(t);
+    if (!selected(name)) {
+      continue;
+    }
+    printResult(name, runBench(states, reps, perf, [&](BoardState &st) {
+      return sudorix_technique_run(t, st.board, analyses[(size_t)(&st - states.data())]);
+    }), showPerf);
+  }
+
+  // Whole-puzzle throughput: one call per puzzle vs puzzles packed into batch calls.
+  if (selected("sudorix_solver_full")) {
+    char out81[82];
+    printResult("sudorix_solver_full", runBench(puzzles, reps, perf, [&](std::string &p) {
+      return sudorix_solver_full(p.c_str(), out81) + out81[40];
+    }), showPerf);
+  }
+
+  if (selected("sudorix_solver_full_batch")) {
+    std::vector<std::string> chunks;
+    for (size_t i = 0; i < puzzles.size(); i += batchSize) {
+      std::string chunk;
+      for (size_t j = i; j < puzzles.size() && j < i + batchSize; j++) {
+        chunk += puzzles[j];
+      }
+      chunks.push_back(chunk);
+    }
+    std::string out(batchSize * 81, '\0');
+    // ns/op is per puzzle; a short last chunk skews it slightly, as --puzzles rarely divides evenly
+    printResult("sudorix_solver_full_batch", runBench(chunks, reps, perf, [&](std::string &c) {
+      return sudorix_solver_full_batch(c.data(), &out[0], (uint32_t)(c.size() / 81)) + out[40];
+    }, std::max<size_t>(1, puzzles.size() / std::max<size_t>(1, chunks.size()))), showPerf);
+  }
+
+  if (perfPuzzles) {
+    runPerfPuzzles(puzzles, counters);
+  }
+
+  return 0;
+}
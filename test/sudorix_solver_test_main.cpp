@@ -3,13 +3,21 @@
 #include <cstdlib>
 #include <cstring>
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <fstream>
+#include <iomanip>
 #include <iostream>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "solver.hpp"
+#include "Event.hpp"
+#include "job_pool.hpp"
+#include "solution_store.hpp"
 
 static inline bool isDigitChar(char c) {
   return c >= '0' && c <= '9';
@@ -134,25 +142,28 @@ static bool validateSolution(const std::string &in81, const std::string &out81,
     }
   }
 
-  // Build unit indices once
-  static std::vector<std::vector<int>> rows;
-  static std::vector<std::vector<int>> cols;
-  static std::vector<std::vector<int>> boxes;
+  // Build unit indices once (thread-safe static initialization, workers share them)
+  struct Units {
+    std::vector<std::vector<int>> rows;
+    std::vector<std::vector<int>> cols;
+    std::vector<std::vector<int>> boxes;
 
-  if (rows.empty()) {
-    rows.resize(9);
-    cols.resize(9);
-    boxes.resize(9);
-    for (int r = 0; r < 9; r++) {
-      for (int c = 0; c < 9; c++) {
-        int idx = r * 9 + c;
-        rows[(size_t)r].push_back(idx);
-        cols[(size_t)c].push_back(idx);
-        int b = (r / 3) * 3 + (c / 3);
-        boxes[(size_t)b].push_back(idx);
+    Units() : rows(9), cols(9), boxes(9) {
+      for (int r = 0; r < 9; r++) {
+        for (int c = 0; c < 9; c++) {
+          int idx = r * 9 + c;
+          rows[(size_t)r].push_back(idx);
+          cols[(size_t)c].push_back(idx);
+          int b = (r / 3) * 3 + (c / 3);
+          boxes[(size_t)b].push_back(idx);
+        }
       }
     }
-  }
+  };
+  static const Units units;
+  const std::vector<std::vector<int>> &rows = units.rows;
+  const std::vector<std::vector<int>> &cols = units.cols;
+  const std::vector<std::vector<int>> &boxes = units.boxes;
 
   // Check all rows/cols/boxes contain 1..9 exactly once.
   for (int u = 0; u < 9; u++) {
@@ -186,11 +197,13 @@ static bool validateSolution(const std::string &in81, const std::string &out81,
   return true;
 }
 
-static int runFullSolveOne(const std::string &in81, std::string *out81, std::string *why) {
+static int runFullSolveOne(const std::string &in81, std::string *out81, std::string *why,
+                           const SudorixBudget *budget) {
   char outBuf[82];
   std::memset(outBuf, 0, sizeof(outBuf));
 
-  int rc = sudorix_solver_full(in81.c_str(), outBuf);
+  int rc = budget ? sudorix_solver_full_budget(in81.c_str(), outBuf, budget)
+                  : sudorix_solver_full(in81.c_str(), outBuf);
 
   // Ensure null termination for printing even if solver returns non-terminated out.
   outBuf[81] = '\0';
@@ -203,38 +216,830 @@ static int runFullSolveOne(const std::string &in81, std::string *out81, std::str
     }
     return 0;
   }
+  if (rc == SUDORIX_BUDGET_EXHAUSTED || rc == SUDORIX_CANCELLED) {
+    if (why) {
+      *why = (rc == SUDORIX_CANCELLED) ? "cancelled" : "budget exhausted";
+    }
+    return 0;
+  }
+
+  std::string w;
+  if (!validateSolution(in81, *out81, &w)) {
+    if (why) {
+      *why = w;
+    }
+    return 0;
+  }
+
+  return 1;
+}
+
+// Brute-force oracle: candidate masks with naked/hidden single propagation,
+// then backtracking on the most constrained cell.
+// Used as the known solution when validating single steps.
+struct OracleState {
+  uint8_t grid[81];
+  uint16_t cands[81];
+};
+
+struct OracleTables {
+  int units[27][9];   // rows, cols, boxes
+  int peers[81][20];
+
+  OracleTables() {
+    for (int u = 0; u < 9; u++) {
+      for (int k = 0; k < 9; k++) {
+        units[u][k] = u * 9 + k;
+        units[9 + u][k] = k * 9 + u;
+        units[18 + u][k] = ((u / 3) * 3 + k / 3) * 9 + (u % 3) * 3 + k % 3;
+      }
+    }
+    for (int i = 0; i < 81; i++) {
+      int n = 0;
+      for (int j = 0; j < 81; j++) {
+        const bool peer = (j / 9 == i / 9) || (j % 9 == i % 9) ||
+                          ((j / 27 == i / 27) && ((j % 9) / 3 == (i % 9) / 3));
+        if (peer && j != i) {
+          peers[i][n++] = j;
+        }
+      }
+    }
+  }
+};
+
+static const OracleTables &oracleTables() {
+  static const OracleTables tables;
+  return tables;
+}
+
+// Place digit d at idx and remove it from the peers. Returns false on contradiction.
+static bool oracleAssign(OracleState &st, int idx, int d) {
+  const OracleTables &t = oracleTables();
+  const uint16_t bit = bitForDigit(d);
+  if ((st.cands[idx] & bit) == 0) {
+    return false;
+  }
+  st.grid[idx] = (uint8_t)d;
+  st.cands[idx] = bit;
+  for (int p : t.peers[idx]) {
+    if (st.cands[p] & bit) {
+      if (st.grid[p] != 0) {
+        return false;
+      }
+      st.cands[p] = (uint16_t)(st.cands[p] & ~bit);
+      if (st.cands[p] == 0) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// Apply naked and hidden singles until nothing changes. Returns false on contradiction.
+static bool oraclePropagate(OracleState &st) {
+  const OracleTables &t = oracleTables();
+  bool changed = true;
+  while (changed) {
+    changed = false;
+    for (int i = 0; i < 81; i++) {
+      if (st.grid[i] == 0 && __builtin_popcount(st.cands[i]) == 1) {
+        if (!oracleAssign(st, i, __builtin_ctz(st.cands[i]) + 1)) {
+          return false;
+        }
+        changed = true;
+      }
+    }
+    for (const int *unit : t.units) {
+      uint16_t once = 0;
+      uint16_t twice = 0;
+      uint16_t placed = 0;
+      for (int k = 0; k < 9; k++) {
+        const uint16_t m = st.cands[unit[k]];
+        if (st.grid[unit[k]] != 0) {
+          placed |= m;
+        }
+        twice |= (uint16_t)(once & m);
+        once |= m;
+      }
+      if (once != 0x01FFu) {
+        return false; // some digit has no place in this unit
+      }
+      uint16_t hidden = (uint16_t)(once & ~twice & ~placed);
+      while (hidden) {
+        const uint16_t bit = (uint16_t)(hidden & (0u - hidden));
+        hidden = (uint16_t)(hidden & ~bit);
+        for (int k = 0; k < 9; k++) {
+          if (st.cands[unit[k]] & bit) {
+            if (!oracleAssign(st, unit[k], __builtin_ctz(bit) + 1)) {
+              return false;
+            }
+            break;
+          }
+        }
+        changed = true;
+      }
+    }
+  }
+  return true;
+}
+
+static bool oracleSearch(OracleState &st) {
+  if (!oraclePropagate(st)) {
+    return false;
+  }
+
+  int best = -1;
+  int bestCount = 10;
+  for (int i = 0; i < 81; i++) {
+    if (st.grid[i] != 0) {
+      continue;
+    }
+    const int count = __builtin_popcount(st.cands[i]);
+    if (count < bestCount) {
+      best = i;
+      bestCount = count;
+      if (count == 2) {
+        break;
+      }
+    }
+  }
+
+  if (best < 0) {
+    return true; // no empty cell left
+  }
+
+  uint16_t mask = st.cands[best];
+  while (mask) {
+    const uint16_t bit = (uint16_t)(mask & (0u - mask));
+    mask = (uint16_t)(mask & ~bit);
+    OracleState next = st;
+    if (oracleAssign(next, best, __builtin_ctz(bit) + 1) && oracleSearch(next)) {
+      st = next;
+      return true;
+    }
+  }
+  return false;
+}
+
+// Fills sol[81] with digits 1..9. Returns false if the givens conflict or no solution exists.
+static bool oracleSolve(const std::string &in81, uint8_t sol[81]) {
+  OracleState st;
+  std::memset(st.grid, 0, sizeof(st.grid));
+  for (int i = 0; i < 81; i++) {
+    st.cands[i] = 0x01FFu;
+  }
+  for (int i = 0; i < 81; i++) {
+    const int d = in81[(size_t)i] - '0';
+    if (d != 0 && !oracleAssign(st, i, d)) {
+      return false;
+    }
+  }
+  if (!oracleSearch(st)) {
+    return false;
+  }
+  std::memcpy(sol, st.grid, 81);
+  return true;
+}
+
+static const char *reasonName(uint32_t reason) {
+  switch ((ReasonId)reason) {
+    case ReasonId::Solver:           return "Solver";
+    case ReasonId::FullHouse:        return "FullHouse";
+    case ReasonId::NakedSingle:      return "NakedSingle";
+    case ReasonId::HiddenSingle:     return "HiddenSingle";
+    case ReasonId::PointingPair:     return "PointingPair";
+    case ReasonId::PointingTriple:   return "PointingTriple";
+    case ReasonId::LockedCandidates: return "LockedCandidates";
+    case ReasonId::BoxLineReduction: return "BoxLineReduction";
+  }
+  return "Unknown";
+}
+
+// Checks one event in out[] layout against the known solution.
+static bool checkStepEvent(const uint32_t *ev, const uint8_t sol[81], std::string *why) {
+  const uint32_t type = ev[0];
+  const uint32_t count = ev[3];
+  for (uint32_t k = 0; k < count; k++) {
+    const uint32_t idx = ev[4 + 2 * k + 0];
+    const uint32_t digit = ev[4 + 2 * k + 1];
+    bool wrong = false;
+    std::ostringstream oss;
+    if (idx >= 81 || digit < 1 || digit > 9) {
+      wrong = true;
+      oss << "operation out of range (idx=" << idx << ", digit=" << digit << ")";
+    } else if (type == (uint32_t)EventType::SetValue && sol[idx] != digit) {
+      wrong = true;
+      oss << "placed " << digit << " at idx=" << idx << ", solution has " << (int)sol[idx];
+    } else if (type == (uint32_t)EventType::RemoveCandidate && sol[idx] == digit) {
+      wrong = true;
+      oss << "eliminated true digit " << digit << " at idx=" << idx;
+    } else if (type != (uint32_t)EventType::SetValue && type != (uint32_t)EventType::RemoveCandidate) {
+      wrong = true;
+      oss << "unknown event type " << type;
+    }
+    if (wrong) {
+      if (why) {
+        *why = std::string(reasonName(ev[1])) + " " + oss.str();
+      }
+      return false;
+    }
+  }
+  return true;
+}
+
+// Human-readable form of one event in out[] layout, e.g. "SetValue HiddenSingle [40=7]".
+static std::string formatEvent(const uint32_t *ev) {
+  std::ostringstream oss;
+  oss << (ev[0] == (uint32_t)EventType::SetValue ? "SetValue" : "RemoveCandidate")
+      << " " << reasonName(ev[1]) << " [";
+  for (uint32_t k = 0; k < ev[3]; k++) {
+    oss << (k ? " " : "") << ev[4 + 2 * k + 0] << "=" << ev[4 + 2 * k + 1];
+  }
+  oss << "]";
+  return oss.str();
+}
+
+// Checks a whole board state against the known solution: every placed value must match
+// and every unsolved cell must still hold its true digit as a candidate.
+// Catches side effects that are not part of the event (peer clearing, auto placement).
+static bool checkBoardState(const uint8_t values[81], const uint16_t cands[81], const uint8_t sol[81],
+                            std::string *why) {
+  for (int i = 0; i < 81; i++) {
+    std::ostringstream oss;
+    if (values[i] != 0 && values[i] != sol[i]) {
+      oss << "idx=" << i << " holds " << (int)values[i] << ", solution has " << (int)sol[i];
+    } else if (values[i] == 0 && (cands[i] & bitForDigit(sol[i])) == 0) {
+      oss << "idx=" << i << " lost true digit " << (int)sol[i] << " from its candidates";
+    } else {
+      continue;
+    }
+    if (why) {
+      *why = oss.str();
+    }
+    return false;
+  }
+  return true;
+}
+
+// Step/diff modes: round-trip the solver state through sudorix_solver_snapshot and
+// sudorix_solver_restore every N steps (0 = never). Set once before workers start.
+static size_t g_snapshotEvery = 0;
+
+// Saves the state, clobbers it with a fresh init of the same puzzle, then restores it.
+static bool snapshotRoundTrip(const std::string &in81, std::string *why) {
+  const int size = sudorix_solver_snapshot(nullptr, 0);
+  std::vector<uint8_t> blob((size_t)std::max(size, 0));
+  if (size <= 0 || sudorix_solver_snapshot(blob.data(), (uint32_t)blob.size()) != size) {
+    *why = "sudorix_solver_snapshot failed";
+    return false;
+  }
+  sudorix_solver_init_board(in81.c_str());
+  if (!sudorix_solver_restore(blob.data(), (uint32_t)blob.size())) {
+    *why = "sudorix_solver_restore rejected a snapshot of " + std::to_string(size) + " bytes";
+    return false;
+  }
+  return true;
+}
+
+// The board-editing helpers of the UI must agree with the solver on the board it reached:
+// no repeated digit, recalculated candidates a superset of the solver's, and peers of the
+// placed digits already cleared.
+static bool checkEditHelpers(const uint8_t values[81], const uint16_t cands[81], std::string *why) {
+  uint32_t report[5];
+  if (!sudorix_solver_check_grid(values, report, 5)) {
+    *why = "sudorix_solver_check_grid returned 0 (failure)";
+    return false;
+  }
+  uint32_t filled = 0;
+  for (int i = 0; i < 81; i++) {
+    filled += values[i] ? 1u : 0u;
+  }
+  if (report[0] != filled || report[1] != 0) {
+    std::ostringstream oss;
+    oss << "sudorix_solver_check_grid: filled=" << report[0] << " (expected " << filled
+        << "), conflict=" << report[1] << " unit=" << report[2] << " digit=" << report[3];
+    *why = oss.str();
+    return false;
+  }
+
+  uint16_t recalc[81];
+  uint16_t cleared[81];
+  std::memcpy(cleared, cands, sizeof(cleared));
+  if (!sudorix_solver_recalc_candidates(values, recalc)) {
+    *why = "sudorix_solver_recalc_candidates returned 0 (failure)";
+    return false;
+  }
+  for (int i = 0; i < 81; i++) {
+    if (values[i] && !sudorix_solver_clear_peers(values, cleared, (uint32_t)i, values[i])) {
+      *why = "sudorix_solver_clear_peers returned 0 (failure)";
+      return false;
+    }
+  }
+  for (int i = 0; i < 81; i++) {
+    const bool ok = values[i] ? recalc[i] == bitForDigit(values[i]) : (cands[i] & ~recalc[i]) == 0;
+    if (!ok || cleared[i] != cands[i]) {
+      std::ostringstream oss;
+      oss << "edit helpers disagree at r" << (i / 9 + 1) << "c" << (i % 9 + 1) << ": solver=0x" << std::hex
+          << cands[i] << " recalc=0x" << recalc[i] << " cleared=0x" << cleared[i];
+      *why = oss.str();
+      return false;
+    }
+  }
+  return true;
+}
+
+// Step/diff modes: before every step, ask sudorix_solver_hint_best (lookahead budget in us,
+// -1 = off) for a hint on the current board and check it against the solution.
+// sudorix_solver_hint_all is asked too: every deduction it lists must be right, the
+// hint_best one among them, and a buffer holding only the first must still count them all.
+// The step-by-step state is saved and restored around the hints, which clear it.
+static long g_checkHintsUs = -1;
+
+static bool checkBestHint(const uint8_t sol[81], std::string *why) {
+  uint8_t values[81];
+  uint16_t cands[81];
+  uint8_t blob[4096];
+  sudorix_solver_export_board(values, cands);
+  const int size = sudorix_solver_snapshot(blob, sizeof(blob));
+  if (size <= 0) {
+    *why = "sudorix_solver_snapshot failed before hint";
+    return false;
+  }
+
+  uint32_t hint[1024];
+  const int ok = sudorix_solver_hint_best(values, cands, hint, 1024, SUDORIX_TIER_ALL, (uint32_t)g_checkHintsUs);
+  std::string w;
+  bool good = !ok || checkStepEvent(hint, sol, &w);
+  if (!good) {
+    w = "hint_best: " + w;
+  }
+
+  // every deduction of sudorix_solver_hint_all must be right, and the ranked hint one of them
+  static thread_local std::vector<uint32_t> all(1u << 16);
+  uint32_t available = 0;
+  const int n = sudorix_solver_hint_all(values, cands, SUDORIX_TECH_ALL, all.data(), (uint32_t)all.size(),
+                                        &available);
+  if (good && n == SUDORIX_INVALID_INPUT) {
+    good = false;
+    w = "hint_all: board refused";
+  } else if (good && (uint32_t)n != available) {
+    good = false;
+    w = "hint_all: truncated";
+  }
+  bool rankedListed = !ok;
+  const uint32_t *ev = all.data();
+  for (int k = 0; good && k < n; k++) {
+    const uint32_t words = 4u + 2u * ev[3];
+    good = checkStepEvent(ev, sol, &w);
+    if (!good) {
+      w = "hint_all: " + w;
+    }
+    if (ok && ev[0] == hint[0] && ev[1] == hint[1] && ev[3] == hint[3] &&
+        std::equal(ev + 4, ev + words, hint + 4)) {
+      rankedListed = true;
+    }
+    ev += words;
+  }
+  if (good && ok && !rankedListed) {
+    good = false;
+    w = "hint_best returned " + formatEvent(hint) + ", not listed by hint_all";
+  }
+  if (good && n > 1) {
+    // a buffer holding only the first event: one written, all still counted
+    uint32_t avail2 = 0;
+    const int n2 = sudorix_solver_hint_all(values, cands, SUDORIX_TECH_ALL, all.data(), 4u + 2u * all[3], &avail2);
+    if (n2 != 1 || avail2 != available) {
+      good = false;
+      w = "hint_all: bad truncation report";
+    }
+  }
+
+  if (!sudorix_solver_restore(blob, (uint32_t)size)) {
+    *why = "sudorix_solver_restore failed after hint";
+    return false;
+  }
+  if (!good) {
+    *why = w;
+  }
+  return good;
+}
+
+// Outcome of a step-by-step solve checked against the solution.
+enum StepStatus {
+  STEP_SOLVED,   // solved, every event right
+  STEP_STALLED,  // no wrong event, but the pipeline stopped short of the solution
+  STEP_WRONG     // a wrong event or board, or a failure of the C API
+};
+
+// Step-based runner: drives sudorix_solver_next_step until no event is produced,
+// validating every event against the given solution and timing each call.
+// With checkBoard, the exported board is also checked after every step.
+static StepStatus runStepWithSolution(const std::string &in81, const uint8_t sol[81], bool checkBoard,
+                                      std::string *out81, std::string *why, size_t *steps, uint64_t *stepNs) {
+  *steps = 0;
+  *stepNs = 0;
+  *out81 = std::string(81, '.');
+
+  if (!sudorix_solver_init_board(in81.c_str())) {
+    if (why) {
+      *why = "sudorix_solver_init_board returned 0 (failure)";
+    }
+    return STEP_WRONG;
+  }
+
+  uint32_t ev[1024];
+  uint8_t values[81];
+  uint16_t cands[81];
+  const int guardMax = 200000;
+  for (int guard = 0; guard < guardMax; guard++) {
+    if (g_checkHintsUs >= 0) {
+      std::string w;
+      if (!checkBestHint(sol, &w)) {
+        if (why) {
+          std::ostringstream oss;
+          oss << "Step " << (*steps + 1) << ": " << w;
+          *why = oss.str();
+        }
+        return STEP_WRONG;
+      }
+    }
+
+    const auto t0 = std::chrono::steady_clock::now();
+    const int ok = sudorix_solver_next_step(ev, 1024);
+    const auto t1 = std::chrono::steady_clock::now();
+    *stepNs += (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count();
+    if (!ok) {
+      break;
+    }
+    ++*steps;
+
+    // Stop at the first wrong event: that is the minimal failure to report.
+    std::string w;
+    bool good = checkStepEvent(ev, sol, &w);
+    if (good && g_snapshotEvery && *steps % g_snapshotEvery == 0) {
+      good = snapshotRoundTrip(in81, &w);
+    }
+    if (good && checkBoard) {
+      sudorix_solver_export_board(values, cands);
+      good = checkBoardState(values, cands, sol, &w);
+      if (!good) {
+        w = "board after " + formatEvent(ev) + ": " + w;
+      }
+    }
+    if (!good) {
+      if (why) {
+        std::ostringstream oss;
+        oss << "Step " << *steps << ": " << w;
+        *why = oss.str();
+      }
+      return STEP_WRONG;
+    }
+  }
+
+  if (!sudorix_solver_export_board(values, cands)) {
+    if (why) {
+      *why = "sudorix_solver_export_board returned 0 (failure)";
+    }
+    return STEP_WRONG;
+  }
+  for (int i = 0; i < 81; i++) {
+    (*out81)[(size_t)i] = values[i] ? (char)('0' + values[i]) : '.';
+  }
 
   std::string w;
+  if (!checkEditHelpers(values, cands, &w)) {
+    if (why) {
+      *why = w;
+    }
+    return STEP_WRONG;
+  }
   if (!validateSolution(in81, *out81, &w)) {
+    if (why) {
+      *why = w;
+    }
+    // every event was checked, so only empty cells can be left: report a stall as such
+    for (int i = 0; i < 81; i++) {
+      if (values[i] != 0 && values[i] != sol[i]) {
+        return STEP_WRONG;
+      }
+    }
+    return STEP_STALLED;
+  }
+
+  return STEP_SOLVED;
+}
+
+static int runStepSolveOne(const std::string &in81, std::string *out81, std::string *why,
+                           size_t *steps, uint64_t *stepNs) {
+  uint8_t sol[81];
+  if (!oracleSolve(in81, sol)) {
+    *steps = 0;
+    *stepNs = 0;
+    *out81 = std::string(81, '.');
+    if (why) {
+      *why = "oracle found no solution";
+    }
+    return 0;
+  }
+  return runStepWithSolution(in81, sol, false, out81, why, steps, stepNs) == STEP_SOLVED ? 1 : 0;
+}
+
+// Differential runner: logical pipeline vs brute-force oracle.
+// Times both engines on the same puzzle, then replays the logical solve step by step
+// and checks every event and the board after it against the oracle solution.
+// A puzzle the logical solver cannot finish is only a failure of coverage: it passes
+// the differential check as long as no wrong deduction was made.
+static int runDiffSolveOne(const std::string &in81, std::string *out81, std::string *why,
+                           size_t *steps, uint64_t *stepNs, uint64_t *logicalNs, uint64_t *oracleNs) {
+  uint8_t sol[81];
+  const auto t0 = std::chrono::steady_clock::now();
+  const bool solved = oracleSolve(in81, sol);
+  const auto t1 = std::chrono::steady_clock::now();
+  *oracleNs = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count();
+
+  char fullBuf[82];
+  const auto t2 = std::chrono::steady_clock::now();
+  const int fullOk = sudorix_solver_full(in81.c_str(), fullBuf);
+  const auto t3 = std::chrono::steady_clock::now();
+  *logicalNs = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(t3 - t2).count();
+  fullBuf[81] = '\0';
+
+  *steps = 0;
+  *stepNs = 0;
+  *out81 = std::string(fullBuf, 81);
+
+  if (!solved) {
+    if (why) {
+      *why = "oracle found no solution";
+    }
+    return 0;
+  }
+  if (!fullOk) {
+    if (why) {
+      *why = "sudorix_solver_full returned 0 (failure)";
+    }
+    return 0;
+  }
+
+  std::string stepOut;
+  std::string w;
+  if (runStepWithSolution(in81, sol, true, &stepOut, &w, steps, stepNs) == STEP_WRONG) {
     if (why) {
       *why = w;
     }
     return 0;
   }
 
+  // Both drivers share compute_next_event, so they must stall on the same board.
+  if (stepOut != *out81) {
+    if (why) {
+      *why = "full and step solvers diverged: " + stepOut;
+    }
+    return 0;
+  }
+
+  for (int i = 0; i < 81; i++) {
+    const char c = (*out81)[(size_t)i];
+    if (c != '.' && c != (char)('0' + sol[i])) {
+      if (why) {
+        std::ostringstream oss;
+        oss << "full solver placed " << c << " at idx=" << i << ", solution has " << (int)sol[i];
+        *why = oss.str();
+      }
+      return 0;
+    }
+  }
+
   return 1;
 }
 
-// Future: step-based runner stub.
-// For now it just calls full solve, but the structure is here to extend.
-static int runStepSolveOne(const std::string &in81, std::string *out81, std::string *why) {
-  (void)why;
-  // TODO: implement when you expose an "export" or allow reading internal board after next_step loop.
-  // A possible approach:
-  //   sudorix_solver_init_board(in81.c_str());
-  //   loop:
-  //     sudorix_solver_next_step(outEvent);
-  //     if outEvent.type==0 break;
-  //   sudorix_solver_export(out81) OR pass out81 as an output parameter.
-  //
-  // For now, fall back to full.
-  return runFullSolveOne(in81, out81, why);
+// One non-blank, non-comment line of the input file.
+struct PuzzleEntry {
+  size_t lineNo;
+  std::string text;   // trimmed line, as read
+  std::string in81;   // normalized puzzle (empty if invalid)
+  std::string err;    // parse error (if in81 is empty)
+};
+
+// Full mode: also ask sudorix_solver_backdoor for a smallest reveal set, with this
+// search budget in us (-1 = off). Set once before workers start.
+static long g_checkBackdoorUs = -1;
+
+// The set must be empty exactly when the pipeline solves the puzzle alone (pipelineSolved),
+// use the oracle's digits, let sudorix_solver_full finish once revealed, and be smallest at
+// least against single reveals. A second call must be answered from the cache, identically.
+static bool checkBackdoor(const std::string &in81, bool pipelineSolved, int *size, uint64_t *ns,
+                          std::string *why) {
+  uint32_t out[1 + 2 * 81];
+  const auto t0 = std::chrono::steady_clock::now();
+  const int rc = sudorix_solver_backdoor(in81.c_str(), 0, (uint32_t)g_checkBackdoorUs, out, 1 + 2 * 81);
+  *ns = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - t0).count();
+  *size = -1;
+  if (rc == SUDORIX_BUDGET_EXHAUSTED) {
+    *why = "budget exhausted";
+    return false;
+  }
+  if (rc != 1) {
+    *why = "sudorix_solver_backdoor returned " + std::to_string(rc);
+    return false;
+  }
+  *size = (int)out[0];
+
+  uint32_t again[1 + 2 * 81];
+  if (sudorix_solver_backdoor(in81.c_str(), 0, 1, again, 1 + 2 * 81) != 1 ||
+      !std::equal(out, out + 1 + 2 * out[0], again)) {
+    *why = "cached answer differs";
+    return false;
+  }
+  if ((out[0] == 0) != pipelineSolved) {
+    *why = pipelineSolved ? "reveals cells of a puzzle the pipeline solves" : "empty set for a stalled puzzle";
+    return false;
+  }
+  if (out[0] == 0) {
+    return true;
+  }
+
+  uint8_t sol[81];
+  if (!oracleSolve(in81, sol)) {
+    *why = "oracle found no solution";
+    return false;
+  }
+  std::string revealed = in81;
+  for (uint32_t k = 0; k < out[0]; k++) {
+    const uint32_t idx = out[1 + 2 * k];
+    const uint32_t digit = out[2 + 2 * k];
+    if (idx >= 81 || in81[idx] != '0' || digit != sol[idx]) {
+      *why = "bad reveal idx=" + std::to_string(idx) + " digit=" + std::to_string(digit);
+      return false;
+    }
+    revealed[idx] = (char)('0' + digit);
+  }
+  std::string solved;
+  std::string w;
+  if (!runFullSolveOne(revealed, &solved, &w, nullptr)) {
+    *why = "pipeline still stalls after the reveals: " + w;
+    return false;
+  }
+  if (out[0] >= 2) {
+    for (int i = 0; i < 81; i++) {
+      if (in81[(size_t)i] != '0') {
+        continue;
+      }
+      std::string one = in81;
+      one[(size_t)i] = (char)('0' + sol[i]);
+      if (runFullSolveOne(one, &solved, &w, nullptr)) {
+        *why = "not smallest: revealing idx=" + std::to_string(i) + " alone is enough";
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// Full/batch mode: puzzles found in this solution store (--store) take its solution
+// instead of being solved, as a catalogue front end would. Opened once before workers start.
+static SolutionStore g_store;
+static bool g_useStore = false;
+
+// Stored solution of in81, validated like a solved one. Returns false on a miss.
+static bool lookupStore(const std::string &in81, std::string *out81, int *ok, std::string *why) {
+  SolutionStore::Entry entry;
+  if (!g_useStore || !g_store.lookup(in81.c_str(), &entry)) {
+    return false;
+  }
+  out81->assign(entry.solution, 81);
+  *ok = validateSolution(in81, *out81, why);
+  return true;
+}
+
+// Batch mode: also solve every puzzle with sudorix_solver_full and require the same output
+// (81 '.' where it fails), invalid and unsolvable puzzles included. Set once before workers start.
+static bool g_checkFull = false;
+
+// Outcome of a single puzzle, stored by input position.
+struct PuzzleResult {
+  int ok = 0;
+  std::string out81;
+  std::string why;
+  size_t steps = 0;        // step/diff mode only
+  uint64_t stepNs = 0;     // step/diff mode only, time spent inside sudorix_solver_next_step
+  uint64_t logicalNs = 0;  // diff mode only, sudorix_solver_full
+  uint64_t oracleNs = 0;   // diff mode only, brute-force oracle
+  bool stalled = false;    // diff mode only, logical solver did not finish
+  int backdoorSize = -1;   // --check-backdoor only, size of the set (-1 = none)
+  uint64_t backdoorNs = 0;
+  bool backdoorBad = false;
+  bool fromStore = false;  // --store only, solution taken from the store
+  bool batchDiffers = false;  // --check-full only, batch output differs from sudorix_solver_full
+};
+
+// Batch mode: the whole shard goes through a single sudorix_solver_full_batch call,
+// then every output is validated like in full mode.
+static void runBatchShard(const std::vector<PuzzleEntry> &entries,
+                          std::vector<PuzzleResult> &results,
+                          size_t begin,
+                          size_t end) {
+  std::string in;
+  std::vector<size_t> slots;
+  for (size_t i = begin; i < end; i++) {
+    if (entries[i].in81.empty()) {
+      results[i].ok = 0;
+      results[i].why = entries[i].err;
+      continue;
+    }
+    if (lookupStore(entries[i].in81, &results[i].out81, &results[i].ok, &results[i].why)) {
+      results[i].fromStore = true;
+      continue;
+    }
+    in += entries[i].in81;
+    slots.push_back(i);
+  }
+
+  std::string out(in.size(), '\0');
+  const int rc = sudorix_solver_full_batch(in.data(), &out[0], (uint32_t)slots.size());
+  for (size_t k = 0; k < slots.size(); k++) {
+    PuzzleResult &r = results[slots[k]];
+    r.out81 = out.substr(k * 81, 81);
+    if (rc == 0) {
+      r.ok = 0;
+      r.why = "sudorix_solver_full_batch returned 0 (failure)";
+      continue;
+    }
+    if (g_checkFull) {
+      char expected[82];
+      if (!sudorix_solver_full(entries[slots[k]].in81.c_str(), expected)) {
+        std::memset(expected, '.', 81);
+      }
+      if (r.out81.compare(0, 81, expected, 81) != 0) {
+        r.ok = 0;
+        r.why = "differs from sudorix_solver_full: " + std::string(expected, 81);
+        r.batchDiffers = true;
+        continue;
+      }
+    }
+    r.ok = validateSolution(entries[slots[k]].in81, r.out81, &r.why);
+  }
+}
+
+// Solve entries [begin, end) on the calling thread.
+// The solver keeps its context per thread, so shards never share state.
+static void runShard(const std::vector<PuzzleEntry> &entries,
+                     std::vector<PuzzleResult> &results,
+                     size_t begin,
+                     size_t end,
+                     const std::string &mode,
+                     const SudorixBudget *budget) {
+  if (mode == "batch") {
+    runBatchShard(entries, results, begin, end);
+    return;
+  }
+  for (size_t i = begin; i < end; i++) {
+    const PuzzleEntry &e = entries[i];
+    PuzzleResult &r = results[i];
+    if (e.in81.empty()) {
+      r.ok = 0;
+      r.why = e.err;
+      continue;
+    }
+    if (mode == "full") {
+      if (lookupStore(e.in81, &r.out81, &r.ok, &r.why)) {
+        r.fromStore = true;
+        continue;
+      }
+      r.ok = runFullSolveOne(e.in81, &r.out81, &r.why, budget);
+      std::string w;
+      if (g_checkBackdoorUs >= 0 && !checkBackdoor(e.in81, r.ok != 0, &r.backdoorSize, &r.backdoorNs, &w)) {
+        r.ok = 0;
+        r.why = "backdoor: " + w;
+        r.backdoorBad = true;
+      }
+    } else if (mode == "diff") {
+      r.ok = runDiffSolveOne(e.in81, &r.out81, &r.why, &r.steps, &r.stepNs, &r.logicalNs, &r.oracleNs);
+      r.stalled = r.out81.find('.') != std::string::npos;
+    } else {
+      r.ok = runStepSolveOne(e.in81, &r.out81, &r.why, &r.steps, &r.stepNs);
+    }
+  }
 }
 
 static void usage(const char *argv0) {
   std::cerr
-      << "Usage: " << argv0 << " <sudoku_file.txt> [--mode=full|step]\n"
-      << "  Each non-empty, non-comment line must contain 81 chars: digits 0-9 or '.' for empty.\n";
+      << "Usage: " << argv0 << " <sudoku_file.txt> [--mode=full|step|diff|batch] [--jobs=N] [--summary]\n"
+      << "  Each non-empty, non-comment line must contain 81 chars: digits 0-9 or '.' for empty.\n"
+      << "  --mode=batch solve each shard with one sudorix_solver_full_batch call (vector lanes)\n"
+      << "  --check-full  batch: require the output of sudorix_solver_full for every puzzle, invalid ones too\n"
+      << "  --mode=diff  check every step against a brute-force oracle and time both engines\n"
+      << "  --jobs=N   shard the puzzles over N worker threads (0 = hardware concurrency)\n"
+      << "  --chunk=N  puzzles handed to a worker at a time (default 64)\n"
+      << "  --pin      pin each worker thread to its own CPU (Linux)\n"
+      << "  --summary  print only the final summary line\n"
+      << "  --max-steps=N --max-evals=N --deadline-ns=N\n"
+      << "             per-puzzle budget for --mode=full (steps, technique passes, wall-clock)\n"
+      << "  --snapshot-every=N  step/diff: snapshot + restore the solver state every N steps\n"
+      << "  --check-hints=US  step/diff: check hint_best (lookahead budget US) and hint_all before every step\n"
+      << "  --cancel-after-ms=N  cancel every solve still running N ms after start (--mode=full)\n"
+      << "  --check-backdoor=US  full: check sudorix_solver_backdoor (search budget US, 0 = none) on every puzzle\n"
+      << "  --store=PATH  full/batch: take the solution of puzzles found in this store (bin/sudorix_store)\n";
 }
 
 int main(int argc, char **argv) {
@@ -245,18 +1050,75 @@ int main(int argc, char **argv) {
 
   std::string path = argv[1];
   std::string mode = "full";
+  unsigned jobs = 1;
+  bool summaryOnly = false;
+  SudorixBudget budget = {0, 0, 0, nullptr};
+  bool useBudget = false;
+  long cancelAfterMs = -1;
+  size_t chunkSize = 64;
+  bool pinWorkers = false;
   for (int i = 2; i < argc; i++) {
     std::string a = argv[i];
     if (a.rfind("--mode=", 0) == 0) {
       mode = a.substr(std::strlen("--mode="));
+    } else if (a.rfind("--jobs=", 0) == 0) {
+      jobs = (unsigned)std::strtoul(a.c_str() + std::strlen("--jobs="), nullptr, 10);
+      if (jobs == 0) {
+        jobs = std::max(1u, std::thread::hardware_concurrency());
+      }
+    } else if (a.rfind("--chunk=", 0) == 0) {
+      chunkSize = std::max<size_t>(1, (size_t)std::strtoul(a.c_str() + std::strlen("--chunk="), nullptr, 10));
+    } else if (a == "--pin") {
+      pinWorkers = true;
+    } else if (a == "--summary") {
+      summaryOnly = true;
+    } else if (a.rfind("--max-steps=", 0) == 0) {
+      budget.max_steps = (uint32_t)std::strtoul(a.c_str() + std::strlen("--max-steps="), nullptr, 10);
+      useBudget = true;
+    } else if (a.rfind("--max-evals=", 0) == 0) {
+      budget.max_technique_evals = (uint32_t)std::strtoul(a.c_str() + std::strlen("--max-evals="), nullptr, 10);
+      useBudget = true;
+    } else if (a.rfind("--deadline-ns=", 0) == 0) {
+      budget.deadline_ns = (uint64_t)std::strtoull(a.c_str() + std::strlen("--deadline-ns="), nullptr, 10);
+      useBudget = true;
+    } else if (a.rfind("--snapshot-every=", 0) == 0) {
+      g_snapshotEvery = (size_t)std::strtoul(a.c_str() + std::strlen("--snapshot-every="), nullptr, 10);
+    } else if (a.rfind("--check-hints=", 0) == 0) {
+      g_checkHintsUs = std::strtol(a.c_str() + std::strlen("--check-hints="), nullptr, 10);
+    } else if (a.rfind("--check-backdoor=", 0) == 0) {
+      g_checkBackdoorUs = std::strtol(a.c_str() + std::strlen("--check-backdoor="), nullptr, 10);
+    } else if (a == "--check-full") {
+      g_checkFull = true;
+    } else if (a.rfind("--store=", 0) == 0) {
+      const std::string storePath = a.substr(std::strlen("--store="));
+      if (!g_store.open(storePath.c_str())) {
+        std::cerr << "Failed to open store: " << storePath << "\n";
+        return 2;
+      }
+      g_useStore = true;
+    } else if (a.rfind("--cancel-after-ms=", 0) == 0) {
+      cancelAfterMs = std::strtol(a.c_str() + std::strlen("--cancel-after-ms="), nullptr, 10);
+      useBudget = true;
+    } else {
+      std::cerr << "Unknown option: " << a << "\n";
+      usage(argv[0]);
+      return 2;
     }
   }
 
-  if (mode != "full" && mode != "step") {
+  if (mode != "full" && mode != "step" && mode != "diff" && mode != "batch") {
     std::cerr << "Unknown mode: " << mode << "\n";
     usage(argv[0]);
     return 2;
   }
+  if (g_checkFull && mode != "batch") {
+    std::cerr << "--check-full only applies to --mode=batch\n";
+    return 2;
+  }
+  if (g_useStore && mode != "full" && mode != "batch") {
+    std::cerr << "--store only applies to --mode=full and --mode=batch\n";
+    return 2;
+  }
 
   std::ifstream fin(path);
   if (!fin) {
@@ -264,13 +1126,10 @@ int main(int argc, char **argv) {
     return 2;
   }
 
-  size_t total = 0;
-  size_t passed = 0;
-  size_t failed = 0;
-
+  // Read the whole input first, so it can be sharded and printed in order.
+  std::vector<PuzzleEntry> entries;
   std::string line;
   size_t lineNo = 0;
-
   while (std::getline(fin, line)) {
     lineNo++;
 
@@ -279,45 +1138,153 @@ int main(int argc, char **argv) {
     if (in81.empty()) {
       // Either blank/comment, or invalid. Distinguish:
       std::string t = trim(line);
-      if (!t.empty() && t[0] != '#') {
-        total++;
-        failed++;
-        std::cout << "[#" << total << " line " << lineNo << "] "
-                  << "INPUT: " << t << "\n"
-                  << "OUTPUT: " << "(n/a)\n"
-                  << "RESULT: FAILED (" << err << ")\n\n";
+      if (t.empty() || t[0] == '#') {
+        continue;
       }
+      entries.push_back({lineNo, t, "", err});
       continue;
     }
+    entries.push_back({lineNo, "", in81, ""});
+  }
+
+  std::vector<PuzzleResult> results(entries.size());
+
+  // Watchdog raising the shared cancel flag, checked cooperatively by every worker.
+  volatile int32_t cancelFlag = 0;
+  std::thread watchdog;
+  std::atomic<bool> done(false);
+  if (cancelAfterMs >= 0) {
+    budget.cancel = &cancelFlag;
+    watchdog = std::thread([&]() {
+      const auto until = std::chrono::steady_clock::now() + std::chrono::milliseconds(cancelAfterMs);
+      while (!done.load() && std::chrono::steady_clock::now() < until) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+      __atomic_store_n(&cancelFlag, 1, __ATOMIC_RELAXED);
+    });
+  }
+  const SudorixBudget *budgetPtr = useBudget ? &budget : nullptr;
 
+  // Chunks of puzzles are handed out to the workers through a lock-free ring,
+  // so slow puzzles do not leave the other workers idle; results land in their input slot.
+  const size_t n = entries.size();
+  JobPool::Stats poolStats;
+  const auto solveStart = std::chrono::steady_clock::now();
+  if (jobs <= 1) {
+    runShard(entries, results, 0, n, mode, budgetPtr);
+  } else {
+    JobPool pool(jobs, pinWorkers);
+    poolStats = pool.run(n, chunkSize, [&](size_t begin, size_t end) {
+      runShard(entries, results, begin, end, mode, budgetPtr);
+    });
+  }
+  const double solveSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - solveStart).count();
+  done.store(true);
+  if (watchdog.joinable()) {
+    watchdog.join();
+  }
+
+  size_t total = 0;
+  size_t passed = 0;
+  size_t failed = 0;
+  size_t totalSteps = 0;
+  uint64_t totalStepNs = 0;
+  uint64_t totalLogicalNs = 0;
+  uint64_t totalOracleNs = 0;
+  size_t stalled = 0;
+  size_t backdoorBad = 0;
+  size_t backdoorSizes[4] = { 0, 0, 0, 0 };  // 0, 1, 2, 3+
+  uint64_t backdoorNs = 0;
+  uint64_t backdoorMaxNs = 0;
+  size_t storeHits = 0;
+  size_t batchDiffers = 0;
+
+  for (size_t i = 0; i < n; i++) {
+    const PuzzleEntry &e = entries[i];
+    const PuzzleResult &r = results[i];
     total++;
 
-    std::string out81;
-    std::string why;
+    if (e.in81.empty()) {
+      failed++;
+      if (!summaryOnly) {
+        std::cout << "[#" << total << " line " << e.lineNo << "] "
+                  << "INPUT: " << e.text << "\n"
+                  << "OUTPUT: " << "(n/a)\n"
+                  << "RESULT: FAILED (" << e.err << ")\n\n";
+      }
+      continue;
+    }
 
-    int ok = 0;
-    if (mode == "full") {
-      ok = runFullSolveOne(in81, &out81, &why);
-    } else {
-      ok = runStepSolveOne(in81, &out81, &why);
+    totalSteps += r.steps;
+    totalStepNs += r.stepNs;
+    totalLogicalNs += r.logicalNs;
+    totalOracleNs += r.oracleNs;
+    stalled += (r.ok && r.stalled) ? 1 : 0;
+    backdoorBad += r.backdoorBad ? 1 : 0;
+    storeHits += r.fromStore ? 1 : 0;
+    batchDiffers += r.batchDiffers ? 1 : 0;
+    if (r.backdoorSize >= 0) {
+      backdoorSizes[std::min(r.backdoorSize, 3)]++;
     }
+    backdoorNs += r.backdoorNs;
+    backdoorMaxNs = std::max(backdoorMaxNs, r.backdoorNs);
 
-    if (ok) {
+    if (r.ok) {
       passed++;
-      std::cout << "[#" << total << " line " << lineNo << "] " << "\n"
-                << "INPUT:  " << in81 << "\n"
-                << "OUTPUT: " << out81 << "\n"
-                << "RESULT: PASSED\n\n";
     } else {
       failed++;
-      std::cout << "[#" << total << " line " << lineNo << "] " << "\n"
-                << "INPUT:  " << in81 << "\n"
-                << "OUTPUT: " << out81 << "\n"
-                << "RESULT: FAILED (" << why << ")\n\n";
+    }
+    if (!summaryOnly) {
+      std::cout << "[#" << total << " line " << e.lineNo << "] " << "\n"
+                << "INPUT:  " << e.in81 << "\n"
+                << "OUTPUT: " << r.out81 << "\n";
+      if (mode == "step" || mode == "diff") {
+        std::cout << "STEPS:  " << r.steps << " (" << (r.steps ? r.stepNs / r.steps : 0) << " ns/step)\n";
+      }
+      if (mode == "diff") {
+        std::cout << "TIME:   logical=" << r.logicalNs << " ns oracle=" << r.oracleNs << " ns"
+                  << (r.stalled ? " (logical stalled)" : "") << "\n";
+      }
+      if (r.ok) {
+        std::cout << "RESULT: PASSED\n\n";
+      } else {
+        std::cout << "RESULT: FAILED (" << r.why << ")\n\n";
+      }
     }
   }
 
   std::cout << "SUMMARY: total=" << total << " passed=" << passed << " failed=" << failed << "\n";
+  // wall clock of the solve phase (reading the file excluded), comparable with the node runner
+  std::cout << "RATE: seconds=" << std::fixed << std::setprecision(3) << solveSeconds
+            << " puzzles_per_sec=" << std::setprecision(1) << (solveSeconds > 0 ? (double)total / solveSeconds : 0.0)
+            << "\n" << std::defaultfloat << std::setprecision(6);
+  if (g_checkBackdoorUs >= 0) {
+    std::cout << "BACKDOOR: bad=" << backdoorBad << " size0=" << backdoorSizes[0] << " size1=" << backdoorSizes[1]
+              << " size2=" << backdoorSizes[2] << " size3+=" << backdoorSizes[3]
+              << " us_per_puzzle=" << (total ? backdoorNs / total / 1000 : 0) << " max_us=" << backdoorMaxNs / 1000 << "\n";
+  }
+  if (g_checkFull) {
+    std::cout << "BATCH: differs=" << batchDiffers << "\n";
+  }
+  if (g_useStore) {
+    std::cout << "STORE: hits=" << storeHits << " misses=" << total - storeHits << "\n";
+  }
+  if (mode == "diff") {
+    std::cout << "DIFF: stalled=" << stalled
+              << " logical_ns=" << totalLogicalNs << " (" << (total ? totalLogicalNs / total : 0) << "/puzzle)"
+              << " oracle_ns=" << totalOracleNs << " (" << (total ? totalOracleNs / total : 0) << "/puzzle)\n";
+  }
+  if (poolStats.chunks > 0) {
+    const uint64_t poolNs = poolStats.workNs + poolStats.queueNs;
+    std::cout << "POOL: workers=" << jobs << " chunks=" << poolStats.chunks << " pinned=" << poolStats.pinned
+              << " queue_overhead=" << std::fixed << std::setprecision(2)
+              << (poolNs ? 100.0 * (double)poolStats.queueNs / (double)poolNs : 0.0) << "%\n";
+  }
+  if (mode == "step" || mode == "diff") {
+    std::cout << "STEPS: total=" << totalSteps
+              << " per_puzzle=" << (total ? (double)totalSteps / (double)total : 0.0)
+              << " ns_per_step=" << (totalSteps ? totalStepNs / totalSteps : 0) << "\n";
+  }
 
   return 0;
 }
@@ -0,0 +1,462 @@
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "solver.hpp"
+#include "techniques.hpp"
+
+// Solve trace recorder and replayer.
+//
+//   sudorix_trace record <sudoku_file.txt> <trace.bin> [--puzzles=N]
+//   sudorix_trace replay <trace.bin> [--verbose]
+//
+// 'record' steps every puzzle with sudorix_solver_next_step and stores, per step,
+// the event (out[] layout), a hash of the board after it, the time of the step and
+// the time of every technique pass run while computing it.
+// 'replay' runs the same puzzles against the current build, reports the first
+// divergent step of each puzzle and the timing deltas per technique.
+//
+// Trace file layout (native byte order):
+//   header : "SDXT" u32 version u32 techniqueCount, then per technique: u8 len + name
+//   puzzle : char in81[81] u32 stepCount, then stepCount steps
+//   step   : u8 type u8 reason u8 fromPrev u8 passCount u16 opCount u16 reserved
+//            u64 boardHash u64 stepNs
+//            opCount x (u8 idx u8 digit)
+//            passCount x (u8 technique u8 reserved u16 produced u32 reserved u64 ns)
+
+static const char TRACE_MAGIC[4] = { 'S', 'D', 'X', 'T' };
+static const uint32_t TRACE_VERSION = 1;
+
+struct TracePass {
+  uint8_t technique;
+  uint16_t produced;
+  uint64_t ns;
+};
+
+struct TraceStep {
+  uint8_t type;
+  uint8_t reason;
+  uint8_t fromPrev;
+  std::vector<uint8_t> ops;  // idx, digit pairs
+  uint64_t boardHash;
+  uint64_t stepNs;
+  std::vector<TracePass> passes;
+};
+
+struct TracePuzzle {
+  std::string in81;
+  std::vector<TraceStep> steps;
+};
+
+// ---------------------------------------------------------
+// Recording
+// ---------------------------------------------------------
+
+static void onPass(void *ctx, size_t technique, size_t produced, uint64_t ns) {
+  std::vector<TracePass> *passes = static_cast<std::vector<TracePass> *>(ctx);
+  passes->push_back({(uint8_t)technique, (uint16_t)std::min<size_t>(produced, 0xFFFFu), ns});
+}
+
+// FNV-1a over the exported values and candidates.
+static uint64_t boardHash() {
+  uint8_t values[81];
+  uint16_t cands[81];
+  sudorix_solver_export_board(values, cands);
+  uint64_t h = 1469598103934665603ull;
+  for (int i = 0; i < 81; i++) {
+    const uint8_t bytes[3] = { values[i], (uint8_t)(cands[i] & 0xFF), (uint8_t)(cands[i] >> 8) };
+    for (uint8_t b : bytes) {
+      h ^= b;
+      h *= 1099511628211ull;
+    }
+  }
+  return h;
+}
+
+// Steps one puzzle to the end. Every step's passes are collected through the pass hook.
+static void solveTraced(const std::string &in81, std::vector<TraceStep> &steps) {
+  steps.clear();
+  if (!sudorix_solver_init_board(in81.c_str())) {
+    return;
+  }
+
+  std::vector<TracePass> passes;
+  sudorix_set_technique_pass_hook(onPass, &passes);
+
+  uint32_t ev[1024];
+  const int guardMax = 200000;
+  for (int guard = 0; guard < guardMax; guard++) {
+    passes.clear();
+    const auto t0 = std::chrono::steady_clock::now();
+    const int ok = sudorix_solver_next_step(ev, 1024);
+    const auto t1 = std::chrono::steady_clock::now();
+    if (!ok) {
+      break;
+    }
+
+    TraceStep st;
+    st.type = (uint8_t)ev[0];
+    st.reason = (uint8_t)ev[1];
+    st.fromPrev = (uint8_t)ev[2];
+    for (uint32_t k = 0; k < ev[3]; k++) {
+      st.ops.push_back((uint8_t)ev[4 + 2 * k + 0]);
+      st.ops.push_back((uint8_t)ev[4 + 2 * k + 1]);
+    }
+    st.boardHash = boardHash();
+    st.stepNs = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count();
+    st.passes = passes;
+    steps.push_back(st);
+  }
+
+  sudorix_set_technique_pass_hook(nullptr, nullptr);
+}
+
+// ---------------------------------------------------------
+// File I/O
+// ---------------------------------------------------------
+
+template <typename T>
+static void put(std::ofstream &out, T v) {
+  out.write(reinterpret_cast<const char *>(&v), sizeof(v));
+}
+
+template <typename T>
+static bool get(std::ifstream &in, T &v) {
+  return (bool)in.read(reinterpret_cast<char *>(&v), sizeof(v));
+}
+
+static void writeHeader(std::ofstream &out) {
+  out.write(TRACE_MAGIC, 4);
+  put<uint32_t>(out, TRACE_VERSION);
+  put<uint32_t>(out, (uint32_t)sudorix_technique_count());
+  for (size_t t = 0; t < sudorix_technique_count(); t++) {
+    const std::string name = sudorix_technique_name(t);
+    put<uint8_t>(out, (uint8_t)name.size());
+    out.write(name.data(), (std::streamsize)name.size());
+  }
+}
+
+static void writePuzzle(std::ofstream &out, const std::string &in81, const std::vector<TraceStep> &steps) {
+  out.write(in81.data(), 81);
+  put<uint32_t>(out, (uint32_t)steps.size());
+  for (const TraceStep &st : steps) {
+    put<uint8_t>(out, st.type);
+    put<uint8_t>(out, st.reason);
+    put<uint8_t>(out, st.fromPrev);
+    put<uint8_t>(out, (uint8_t)st.passes.size());
+    put<uint16_t>(out, (uint16_t)(st.ops.size() / 2));
+    put<uint16_t>(out, 0);
+    put<uint64_t>(out, st.boardHash);
+    put<uint64_t>(out, st.stepNs);
+    out.write(reinterpret_cast<const char *>(st.ops.data()), (std::streamsize)st.ops.size());
+    for (const TracePass &p : st.passes) {
+      put<uint8_t>(out, p.technique);
+      put<uint8_t>(out, 0);
+      put<uint16_t>(out, p.produced);
+      put<uint32_t>(out, 0);
+      put<uint64_t>(out, p.ns);
+    }
+  }
+}
+
+static bool readHeader(std::ifstream &in, std::vector<std::string> &names, std::string *err) {
+  char magic[4];
+  uint32_t version = 0;
+  uint32_t count = 0;
+  if (!in.read(magic, 4) || std::memcmp(magic, TRACE_MAGIC, 4) != 0) {
+    *err = "not a sudorix trace";
+    return false;
+  }
+  if (!get(in, version) || version != TRACE_VERSION) {
+    *err = "unsupported trace version";
+    return false;
+  }
+  if (!get(in, count)) {
+    *err = "truncated header";
+    return false;
+  }
+  for (uint32_t t = 0; t < count; t++) {
+    uint8_t len = 0;
+    if (!get(in, len)) {
+      *err = "truncated header";
+      return false;
+    }
+    std::string name(len, '\0');
+    if (!in.read(&name[0], len)) {
+      *err = "truncated header";
+      return false;
+    }
+    names.push_back(name);
+  }
+  return true;
+}
+
+// Returns false at end of file (or on a truncated record, reported through err).
+static bool readPuzzle(std::ifstream &in, TracePuzzle &pz, std::string *err) {
+  char in81[81];
+  if (!in.read(in81, 81)) {
+    return false;
+  }
+  pz.in81.assign(in81, 81);
+  pz.steps.clear();
+
+  uint32_t count = 0;
+  if (!get(in, count)) {
+    *err = "truncated puzzle record";
+    return false;
+  }
+  pz.steps.resize(count);
+  for (TraceStep &st : pz.steps) {
+    uint8_t passCount = 0;
+    uint16_t opCount = 0;
+    uint16_t reserved16 = 0;
+    bool ok = get(in, st.type) && get(in, st.reason) && get(in, st.fromPrev) && get(in, passCount) &&
+              get(in, opCount) && get(in, reserved16) && get(in, st.boardHash) && get(in, st.stepNs);
+    st.ops.resize((size_t)opCount * 2);
+    ok = ok && in.read(reinterpret_cast<char *>(st.ops.data()), (std::streamsize)st.ops.size());
+    st.passes.resize(passCount);
+    for (TracePass &p : st.passes) {
+      uint8_t reserved8 = 0;
+      uint32_t reserved32 = 0;
+      ok = ok && get(in, p.technique) && get(in, reserved8) && get(in, p.produced) &&
+           get(in, reserved32) && get(in, p.ns);
+    }
+    if (!ok) {
+      *err = "truncated step record";
+      return false;
+    }
+  }
+  return true;
+}
+
+// ---------------------------------------------------------
+// Commands
+// ---------------------------------------------------------
+
+static bool loadPuzzle(const std::string &line, std::string *in81) {
+  std::string compact;
+  for (char c : line) {
+    if (c == '.' || (c >= '0' && c <= '9')) {
+      compact.push_back(c == '.' ? '0' : c);
+    } else if (c == '#') {
+      break;
+    }
+  }
+  if (compact.size() != 81) {
+    return false;
+  }
+  *in81 = compact;
+  return true;
+}
+
+static int cmdRecord(const std::string &puzzlePath, const std::string &tracePath, size_t maxPuzzles) {
+  std::ifstream fin(puzzlePath);
+  if (!fin) {
+    std::cerr << "Failed to open file: " << puzzlePath << "\n";
+    return 2;
+  }
+  std::ofstream out(tracePath, std::ios::binary);
+  if (!out) {
+    std::cerr << "Failed to create trace: " << tracePath << "\n";
+    return 2;
+  }
+
+  writeHeader(out);
+
+  size_t puzzles = 0;
+  size_t totalSteps = 0;
+  std::vector<TraceStep> steps;
+  std::string line;
+  while (puzzles < maxPuzzles && std::getline(fin, line)) {
+    std::string in81;
+    if (!loadPuzzle(line, &in81)) {
+      continue;
+    }
+    solveTraced(in81, steps);
+    writePuzzle(out, in81, steps);
+    puzzles++;
+    totalSteps += steps.size();
+  }
+
+  std::cout << "Recorded " << puzzles << " puzzles, " << totalSteps << " steps to " << tracePath << "\n";
+  return 0;
+}
+
+static bool sameEvent(const TraceStep &a, const TraceStep &b) {
+  return a.type == b.type && a.reason == b.reason && a.fromPrev == b.fromPrev && a.ops == b.ops;
+}
+
+static std::string describe(const TraceStep &st) {
+  std::string s = "type=" + std::to_string(st.type) + " reason=" + std::to_string(st.reason) +
+                  " fromPrev=" + std::to_string(st.fromPrev) + " ops=[";
+  for (size_t k = 0; k + 1 < st.ops.size(); k += 2) {
+    s += (k ? " " : "") + std::to_string(st.ops[k]) + "=" + std::to_string(st.ops[k + 1]);
+  }
+  return s + "]";
+}
+
+static double deltaPct(uint64_t before, uint64_t after) {
+  return before ? 100.0 * ((double)after - (double)before) / (double)before : 0.0;
+}
+
+static int cmdReplay(const std::string &tracePath, bool verbose) {
+  std::ifstream in(tracePath, std::ios::binary);
+  if (!in) {
+    std::cerr << "Failed to open trace: " << tracePath << "\n";
+    return 2;
+  }
+
+  std::string err;
+  std::vector<std::string> names;
+  if (!readHeader(in, names, &err)) {
+    std::cerr << tracePath << ": " << err << "\n";
+    return 2;
+  }
+
+  // Technique timings are compared by name, so reordering the pipeline is fine.
+  const size_t nowCount = sudorix_technique_count();
+  std::vector<uint64_t> oldNs(names.size(), 0);
+  std::vector<uint64_t> newNs(nowCount, 0);
+  uint64_t oldStepNs = 0;
+  uint64_t newStepNs = 0;
+
+  size_t puzzles = 0;
+  size_t diverged = 0;
+  size_t comparedSteps = 0;
+  TracePuzzle pz;
+  std::vector<TraceStep> steps;
+  while (readPuzzle(in, pz, &err)) {
+    puzzles++;
+    solveTraced(pz.in81, steps);
+
+    const size_t n = std::min(pz.steps.size(), steps.size());
+    size_t firstDiff = n;
+    for (size_t k = 0; k < n; k++) {
+      if (!sameEvent(pz.steps[k], steps[k]) || pz.steps[k].boardHash != steps[k].boardHash) {
+        firstDiff = k;
+        break;
+      }
+    }
+
+    // Timing deltas only make sense on the common prefix of identical steps.
+    for (size_t k = 0; k < firstDiff; k++) {
+      const TraceStep &a = pz.steps[k];
+      const TraceStep &b = steps[k];
+      oldStepNs += a.stepNs;
+      newStepNs += b.stepNs;
+      for (const TracePass &p : a.passes) {
+        if (p.technique < oldNs.size()) {
+          oldNs[p.technique] += p.ns;
+        }
+      }
+      for (const TracePass &p : b.passes) {
+        if (p.technique < newNs.size()) {
+          newNs[p.technique] += p.ns;
+        }
+      }
+      if (verbose) {
+        std::cout << "puzzle " << puzzles << " step " << (k + 1) << ": " << a.stepNs << " -> " << b.stepNs
+                  << " ns (" << std::showpos << std::fixed << std::setprecision(1)
+                  << deltaPct(a.stepNs, b.stepNs) << std::noshowpos << "%)\n";
+      }
+    }
+    comparedSteps += firstDiff;
+
+    if (firstDiff < n || pz.steps.size() != steps.size()) {
+      diverged++;
+      std::cout << "DIVERGED puzzle " << puzzles << " (" << pz.in81 << ") at step " << (firstDiff + 1) << "\n";
+      if (firstDiff < n) {
+        std::cout << "  recorded: " << describe(pz.steps[firstDiff])
+                  << " hash=" << std::hex << pz.steps[firstDiff].boardHash << std::dec << "\n"
+                  << "  replayed: " << describe(steps[firstDiff])
+                  << " hash=" << std::hex << steps[firstDiff].boardHash << std::dec << "\n";
+      } else {
+        std::cout << "  recorded " << pz.steps.size() << " steps, replayed " << steps.size() << "\n";
+      }
+    }
+  }
+  if (!err.empty()) {
+    std::cerr << tracePath << ": " << err << "\n";
+    return 2;
+  }
+
+  std::cout << "\n" << std::left << std::setw(28) << "Technique"
+            << std::right << std::setw(16) << "recorded ns" << std::setw(16) << "replayed ns"
+            << std::setw(10) << "delta" << "\n"
+            << std::string(70, '-') << "\n";
+  for (size_t t = 0; t < names.size(); t++) {
+    uint64_t now = 0;
+    for (size_t u = 0; u < nowCount; u++) {
+      if (names[t] == sudorix_technique_name(u)) {
+        now = newNs[u];
+      }
+    }
+    std::cout << std::left << std::setw(28) << names[t]
+              << std::right << std::setw(16) << oldNs[t] << std::setw(16) << now
+              << std::setw(9) << std::showpos << std::fixed << std::setprecision(1)
+              << deltaPct(oldNs[t], now) << std::noshowpos << "%\n";
+  }
+  std::cout << std::left << std::setw(28) << "(all steps)"
+            << std::right << std::setw(16) << oldStepNs << std::setw(16) << newStepNs
+            << std::setw(9) << std::showpos << std::fixed << std::setprecision(1)
+            << deltaPct(oldStepNs, newStepNs) << std::noshowpos << "%\n";
+
+  std::cout << "\nREPLAY: puzzles=" << puzzles << " diverged=" << diverged
+            << " compared_steps=" << comparedSteps << "\n";
+  return diverged ? 1 : 0;
+}
+
+static void usage(const char *argv0) {
+  std::cerr
+      << "Usage: " << argv0 << " record <sudoku_file.txt> <trace.bin> [--puzzles=N]\n"
+      << "       " << argv0 << " replay <trace.bin> [--verbose]\n";
+}
+
+int main(int argc, char **argv) {
+  if (argc < 3) {
+    usage(argv[0]);
+    return 2;
+  }
+
+  const std::string cmd = argv[1];
+  if (cmd == "record" && argc >= 4) {
+    size_t maxPuzzles = (size_t)-1;
+    for (int i = 4; i < argc; i++) {
+      std::string a = argv[i];
+      if (a.rfind("--puzzles=", 0) == 0) {
+        maxPuzzles = (size_t)std::strtoul(a.c_str() + std::strlen("--puzzles="), nullptr, 10);
+      } else {
+        std::cerr << "Unknown option: " << a << "\n";
+        usage(argv[0]);
+        return 2;
+      }
+    }
+    return cmdRecord(argv[2], argv[3], maxPuzzles);
+  }
+  if (cmd == "replay") {
+    bool verbose = false;
+    for (int i = 3; i < argc; i++) {
+      std::string a = argv[i];
+      if (a == "--verbose") {
+        verbose = true;
+      } else {
+        std::cerr << "Unknown option: " << a << "\n";
+        usage(argv[0]);
+        return 2;
+      }
+    }
+    return cmdReplay(argv[2], verbose);
+  }
+
+  usage(argv[0]);
+  return 2;
+}
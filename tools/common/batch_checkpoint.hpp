@@ -0,0 +1,167 @@
+#ifndef BATCH_CHECKPOINT_H
+#define BATCH_CHECKPOINT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+  #include <sys/stat.h>
+  #include <unistd.h>
+  #define BATCH_CHECKPOINT_FSYNC 1
+#endif
+
+// Checkpoint of a long batch run over a puzzle file, kept in a directory:
+//   checkpoint      state after the last finished block: input offset and line number,
+//                   number of output chunks and the partial aggregates of the tool
+//   out.000000 ...  output of each finished block, in input order (append-only: a chunk
+//                   is never rewritten once the checkpoint counts it)
+// The tool reads, solves and commits the input a block at a time. commit() writes the
+// block's chunk, then replaces the checkpoint, both through a temporary file flushed to
+// disk and renamed into place, so a run killed at any point resumes from the last
+// commit: the block in progress is simply done again, and the chunks concatenated are
+// the output of an uninterrupted run. Checkpointing costs two small file writes per
+// block.
+class BatchCheckpoint
+{
+public:
+  // Opens the directory (created if needed) and loads its checkpoint, if any. 'job'
+  // identifies the run (tool, input file and size, options that change the results):
+  // a checkpoint of another job is refused rather than mixed in.
+  bool open(const std::string &directory, const std::string &jobId, size_t counterCount, std::string *err) {
+    dir = directory;
+    job = jobId;
+    state = State();
+    state.counters.assign(counterCount, 0);
+    isResumed = false;
+#if defined(BATCH_CHECKPOINT_FSYNC)
+    mkdir(dir.c_str(), 0755);
+#endif
+
+    std::ifstream in(path("checkpoint"));
+    if (!in) {
+      return true;  // fresh run
+    }
+    State loaded;
+    std::string savedJob;
+    std::string key;
+    while (in >> key) {
+      if (key == "job") {
+        in.get();
+        std::getline(in, savedJob);
+      } else if (key == "offset") {
+        in >> loaded.offset;
+      } else if (key == "line") {
+        in >> loaded.lineNo;
+      } else if (key == "chunks") {
+        in >> loaded.chunks;
+      } else if (key == "done") {
+        in >> loaded.done;
+      } else if (key == "counters") {
+        uint64_t value;
+        while (in.peek() != '\n' && in >> value) {
+          loaded.counters.push_back(value);
+        }
+      } else {
+        *err = "unknown checkpoint entry '" + key + "'";
+        return false;
+      }
+    }
+    if (savedJob != job) {
+      *err = "checkpoint belongs to another job: " + savedJob;
+      return false;
+    }
+    if (loaded.counters.size() != counterCount) {
+      *err = "checkpoint has " + std::to_string(loaded.counters.size()) + " counters, expected " +
+             std::to_string(counterCount);
+      return false;
+    }
+    state = loaded;
+    isResumed = true;
+    return true;
+  }
+
+  bool resumed() const { return isResumed; }
+  bool finished() const { return state.done != 0; }
+  uint64_t offset() const { return state.offset; }
+  uint64_t lineNo() const { return state.lineNo; }
+  uint64_t chunks() const { return state.chunks; }
+
+  // Partial aggregates, restored on resume; the tool updates them block by block.
+  std::vector<uint64_t> &counters() { return state.counters; }
+
+  // Records the block just processed: its output, then the input position after it
+  // (byte offset and line number) and the counters. 'done' marks the end of the input.
+  bool commit(const std::string &output, uint64_t nextOffset, uint64_t nextLineNo, bool done) {
+    char name[32];
+    std::snprintf(name, sizeof(name), "out.%06llu", (unsigned long long)state.chunks);
+    if (!writeFile(name, output)) {
+      return false;
+    }
+    State next = state;
+    next.offset = nextOffset;
+    next.lineNo = nextLineNo;
+    next.chunks++;
+    next.done = done ? 1 : 0;
+
+    std::ostringstream text;
+    text << "job " << job << "\n"
+         << "offset " << next.offset << "\n"
+         << "line " << next.lineNo << "\n"
+         << "chunks " << next.chunks << "\n"
+         << "done " << next.done << "\n"
+         << "counters";
+    for (uint64_t value : next.counters) {
+      text << " " << value;
+    }
+    text << "\n";
+    if (!writeFile("checkpoint", text.str())) {
+      return false;
+    }
+    state = next;
+    return true;
+  }
+
+  // Size of a file in bytes (0 if it cannot be read), for the job id.
+  static uint64_t fileSize(const std::string &file) {
+    std::ifstream in(file, std::ios::binary | std::ios::ate);
+    return in ? (uint64_t)in.tellg() : 0;
+  }
+
+private:
+  struct State {
+    uint64_t offset = 0;
+    uint64_t lineNo = 0;
+    uint64_t chunks = 0;
+    int done = 0;
+    std::vector<uint64_t> counters;
+  };
+
+  std::string path(const std::string &name) const { return dir + "/" + name; }
+
+  // Whole file through "<name>.tmp", flushed to disk, then renamed over 'name'.
+  bool writeFile(const std::string &name, const std::string &data) const {
+    const std::string tmp = path(name + ".tmp");
+    FILE *f = std::fopen(tmp.c_str(), "wb");
+    if (f == nullptr) {
+      return false;
+    }
+    bool ok = std::fwrite(data.data(), 1, data.size(), f) == data.size() && std::fflush(f) == 0;
+#if defined(BATCH_CHECKPOINT_FSYNC)
+    ok = ok && fsync(fileno(f)) == 0;
+#endif
+    ok = (std::fclose(f) == 0) && ok;
+    return ok && std::rename(tmp.c_str(), path(name).c_str()) == 0;
+  }
+
+  std::string dir;
+  std::string job;
+  State state;
+  bool isResumed = false;
+};
+
+#endif // BATCH_CHECKPOINT_H
@@ -0,0 +1,226 @@
+#ifndef JOB_POOL_H
+#define JOB_POOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+  #include <pthread.h>
+  #include <sched.h>
+#endif
+
+// Bounded lock-free multi-producer/multi-consumer ring (Vyukov's sequence-number queue).
+// Each slot carries a sequence number telling whether it is free for the producer of
+// that round or holds a value for the consumer of that round, so push and pop are a
+// single CAS on the shared index plus one store, with no lock and no ABA problem.
+template <typename T>
+class MpmcRing
+{
+public:
+  // capacity is rounded up to a power of two
+  explicit MpmcRing(size_t capacity) {
+    size_t n = 2;
+    while (n < capacity) {
+      n <<= 1;
+    }
+    mask = n - 1;
+    slots.reset(new Slot[n]);
+    for (size_t i = 0; i < n; i++) {
+      slots[i].seq.store(i, std::memory_order_relaxed);
+    }
+    head.store(0, std::memory_order_relaxed);
+    tail.store(0, std::memory_order_relaxed);
+  }
+
+  MpmcRing(const MpmcRing &) = delete;
+  MpmcRing &operator=(const MpmcRing &) = delete;
+
+  // Returns false if the ring is full.
+  bool tryPush(const T &value) {
+    size_t pos = tail.load(std::memory_order_relaxed);
+    while (true) {
+      Slot &slot = slots[pos & mask];
+      const size_t seq = slot.seq.load(std::memory_order_acquire);
+      const intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+      if (diff == 0) {
+        if (tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          slot.value = value;
+          slot.seq.store(pos + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = tail.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  // Returns false if the ring is empty.
+  bool tryPop(T &value) {
+    size_t pos = head.load(std::memory_order_relaxed);
+    while (true) {
+      Slot &slot = slots[pos & mask];
+      const size_t seq = slot.seq.load(std::memory_order_acquire);
+      const intptr_t diff = (intptr_t)seq - (intptr_t)(pos + 1);
+      if (diff == 0) {
+        if (head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          value = slot.value;
+          slot.seq.store(pos + mask + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = head.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+private:
+  struct Slot {
+    std::atomic<size_t> seq;
+    T value;
+  };
+
+  std::unique_ptr<Slot[]> slots;
+  size_t mask;
+  // producers and consumers hammer different indices: keep them on separate cache lines
+  alignas(64) std::atomic<size_t> head;
+  alignas(64) std::atomic<size_t> tail;
+};
+
+// Fixed set of worker threads pulling [begin, end) chunks of a job list from an MpmcRing.
+//
+// Workers live for the whole run, so each keeps one solver context (the thread_local
+// board and queue in solver.cpp) warm across all its chunks. With pinning enabled,
+// worker w is bound to the w-th CPU of the process affinity mask (Linux only); CPUs are
+// taken in kernel order, which keeps consecutive workers on the same NUMA node first.
+class JobPool
+{
+public:
+  struct Chunk {
+    size_t begin;
+    size_t end;
+  };
+
+  struct Stats {
+    size_t chunks = 0;
+    uint64_t workNs = 0;   // inside the job function, summed over workers
+    uint64_t queueNs = 0;  // waiting for / popping chunks, summed over workers
+    unsigned pinned = 0;   // workers whose affinity could be set
+  };
+
+  JobPool(unsigned workers, bool pin) : numWorkers(workers ? workers : 1), pinWorkers(pin) {}
+
+  // Calls fn(begin, end) on the workers for consecutive chunks of 'chunkSize' items
+  // covering [0, count), and returns once all of them are done.
+  template <typename Fn>
+  Stats run(size_t count, size_t chunkSize, Fn fn) {
+    if (chunkSize == 0) {
+      chunkSize = 1;
+    }
+    const size_t numChunks = (count + chunkSize - 1) / chunkSize;
+    MpmcRing<Chunk> ring(std::min<size_t>(std::max<size_t>(numChunks, 2), 4096));
+    std::atomic<bool> closed(false);
+    std::atomic<unsigned> pinned(0);
+    std::vector<Stats> perWorker(numWorkers);
+    std::vector<int> cpus = allowedCpus();
+
+    auto worker = [&](unsigned w) {
+      if (pinWorkers && !cpus.empty() && pinCurrentThread(cpus[w % cpus.size()])) {
+        pinned.fetch_add(1, std::memory_order_relaxed);
+      }
+      Stats &st = perWorker[w];
+      Chunk chunk;
+      auto t0 = std::chrono::steady_clock::now();
+      while (true) {
+        if (!ring.tryPop(chunk)) {
+          if (!closed.load(std::memory_order_acquire)) {
+            std::this_thread::yield();
+            continue;
+          }
+          // the producer closes only after its last push, so an empty ring seen
+          // after 'closed' really is the end
+          if (!ring.tryPop(chunk)) {
+            break;
+          }
+        }
+        const auto t1 = std::chrono::steady_clock::now();
+        fn(chunk.begin, chunk.end);
+        const auto t2 = std::chrono::steady_clock::now();
+        st.queueNs += (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count();
+        st.workNs += (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(t2 - t1).count();
+        st.chunks++;
+        t0 = t2;
+      }
+      st.queueNs += (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now() - t0).count();
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(numWorkers);
+    for (unsigned w = 0; w < numWorkers; w++) {
+      threads.emplace_back(worker, w);
+    }
+    for (size_t c = 0; c < numChunks; c++) {
+      const Chunk chunk = { c * chunkSize, std::min(count, (c + 1) * chunkSize) };
+      while (!ring.tryPush(chunk)) {
+        std::this_thread::yield();
+      }
+    }
+    closed.store(true, std::memory_order_release);
+    for (std::thread &t : threads) {
+      t.join();
+    }
+
+    Stats total;
+    for (const Stats &st : perWorker) {
+      total.chunks += st.chunks;
+      total.workNs += st.workNs;
+      total.queueNs += st.queueNs;
+    }
+    total.pinned = pinned.load();
+    return total;
+  }
+
+private:
+  static std::vector<int> allowedCpus() {
+    std::vector<int> cpus;
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+      for (int c = 0; c < CPU_SETSIZE; c++) {
+        if (CPU_ISSET(c, &set)) {
+          cpus.push_back(c);
+        }
+      }
+    }
+#endif
+    return cpus;
+  }
+
+  static bool pinCurrentThread(int cpu) {
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    (void)cpu;
+    return false;
+#endif
+  }
+
+  unsigned numWorkers;
+  bool pinWorkers;
+};
+
+#endif // JOB_POOL_H
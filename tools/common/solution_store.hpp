@@ -0,0 +1,315 @@
+#ifndef SOLUTION_STORE_H
+#define SOLUTION_STORE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#if defined(__unix__) || defined(__APPLE__)
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+  #define SOLUTION_STORE_MMAP 1
+#endif
+
+// Persistent solution store: an open-addressing hash table in a file, mapped with mmap
+// and used in place, so opening it costs nothing whatever its size and the tools can
+// check a catalogue of known puzzles before solving.
+//
+// File layout: one page of header, then a power of two of 64-byte slots, so a slot
+// never straddles a page (or a cache line). A slot holds a tag from the hash, the
+// solution (one nibble per cell), which cells are givens (the puzzle is the solution
+// restricted to them, so it is not stored twice), the technique tier and a rating.
+// Linear probing with the table at most 3/4 full: a lookup hashes the puzzle and
+// reads one slot, or a few neighbours, in the same page.
+//
+// The key is the puzzle itself (digits 1..9, anything else is an empty cell), not a
+// canonical form: puzzles equal up to symmetry are separate entries.
+//
+// A store is written by create() + insert() + close(), into "<path>.tmp" renamed at
+// close, so a reader never sees a half-built file. Lookups on an opened store are
+// read-only and can run from any number of threads.
+class SolutionStore
+{
+public:
+  static constexpr uint32_t VERSION = 1;
+  static constexpr size_t HEADER_SIZE = 4096;
+
+  struct Entry {
+    char solution[81];  // digits '1'..'9'
+    uint8_t tier;       // SudorixTier that solves it, 0 = not solved by the techniques
+    uint16_t rating;
+  };
+
+  SolutionStore() = default;
+  ~SolutionStore() { close(); }
+
+  SolutionStore(const SolutionStore &) = delete;
+  SolutionStore &operator=(const SolutionStore &) = delete;
+
+  // Maps an existing store read-only. Returns false if the file is missing or not a store.
+  bool open(const char *path) {
+    close();
+#if defined(SOLUTION_STORE_MMAP)
+    const int fd = ::open(path, O_RDONLY);
+    if (fd < 0) {
+      return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < HEADER_SIZE) {
+      ::close(fd);
+      return false;
+    }
+    void *p = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (p == MAP_FAILED) {
+      return false;
+    }
+    base = (uint8_t *)p;
+    mappedSize = (size_t)st.st_size;
+    const Header *h = header();
+    if (std::memcmp(h->magic, MAGIC, sizeof(h->magic)) != 0 || h->version != VERSION ||
+        h->slotSize != sizeof(Slot) || h->slotCount == 0 || (h->slotCount & (h->slotCount - 1)) != 0 ||
+        // bound slotCount by the file before multiplying: a forged count must not wrap around
+        h->slotCount > (mappedSize - HEADER_SIZE) / sizeof(Slot) ||
+        mappedSize != HEADER_SIZE + h->slotCount * sizeof(Slot) || h->entries > h->slotCount) {
+      close();
+      return false;
+    }
+    slotMask = h->slotCount - 1;
+    count = h->entries;
+    // lookups jump around the file: no read-ahead around the touched page
+    madvise(base, mappedSize, MADV_RANDOM);
+    return true;
+#else
+    (void)path;
+    return false;
+#endif
+  }
+
+  // Creates an empty store sized for 'entries' puzzles, to be filled by insert().
+  bool create(const char *path, size_t entries) {
+    close();
+#if defined(SOLUTION_STORE_MMAP)
+    uint64_t slots = 64;
+    while (slots * 3 / 4 < entries) {
+      slots <<= 1;
+    }
+    finalPath = path;
+    tmpPath = finalPath + ".tmp";
+    const int fd = ::open(tmpPath.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+      return false;
+    }
+    const size_t size = HEADER_SIZE + (size_t)slots * sizeof(Slot);
+    if (ftruncate(fd, (off_t)size) != 0) {
+      ::close(fd);
+      return false;
+    }
+    void *p = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (p == MAP_FAILED) {
+      return false;
+    }
+    base = (uint8_t *)p;
+    mappedSize = size;
+    slotMask = slots - 1;
+    count = 0;
+    writable = true;
+    return true;
+#else
+    (void)path;
+    (void)entries;
+    return false;
+#endif
+  }
+
+  // Adds a puzzle (81 chars) with its solution (81 digits). An existing entry for the
+  // puzzle is updated. Returns false if the solution does not fit the givens or the
+  // store is full.
+  bool insert(const char *in81, const char *solution81, uint8_t tier, uint16_t rating) {
+    if (!writable) {
+      return false;
+    }
+    const Key key(in81);
+    Slot probe;
+    std::memset(&probe, 0, sizeof(probe));
+    for (int i = 0; i < 81; i++) {
+      const int s = solution81[i] - '0';
+      if (s < 1 || s > 9) {
+        return false;
+      }
+      probe.solution[i >> 1] |= (uint8_t)(s << ((i & 1) * 4));
+    }
+    std::memcpy(probe.givens, key.givens, sizeof(probe.givens));
+    probe.tier = tier;
+    probe.rating = rating;
+    probe.tag = key.tag;
+    if (!key.matches(probe)) {
+      return false;  // the solution does not keep the givens
+    }
+
+    for (uint64_t k = 0; k <= slotMask; k++) {
+      Slot &slot = slots()[(key.hash + k) & slotMask];
+      if (slot.tag == 0) {
+        if (count + 1 > (slotMask + 1) * 3 / 4) {
+          return false;
+        }
+        slot = probe;
+        count++;
+        return true;
+      }
+      if (key.matches(slot)) {
+        slot = probe;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // Looks a puzzle up (81 chars). Returns false if it is not in the store.
+  bool lookup(const char *in81, Entry *entry) const {
+    if (base == nullptr) {
+      return false;
+    }
+    const Key key(in81);
+    for (uint64_t k = 0; k <= slotMask; k++) {
+      const Slot &slot = slots()[(key.hash + k) & slotMask];
+      if (slot.tag == 0) {
+        return false;
+      }
+      if (key.matches(slot)) {
+        for (int i = 0; i < 81; i++) {
+          entry->solution[i] = (char)('0' + ((slot.solution[i >> 1] >> ((i & 1) * 4)) & 0xF));
+        }
+        entry->tier = slot.tier;
+        entry->rating = slot.rating;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // Unmaps the store; a store being created gets its header and is renamed into place.
+  // Returns false if that final step fails.
+  bool close() {
+    bool ok = true;
+#if defined(SOLUTION_STORE_MMAP)
+    if (base != nullptr) {
+      if (writable) {
+        Header *h = header();
+        std::memcpy(h->magic, MAGIC, sizeof(h->magic));
+        h->version = VERSION;
+        h->slotSize = sizeof(Slot);
+        h->slotCount = slotMask + 1;
+        h->entries = count;
+        ok = msync(base, mappedSize, MS_SYNC) == 0;
+      }
+      munmap(base, mappedSize);
+      if (writable) {
+        ok = ok && std::rename(tmpPath.c_str(), finalPath.c_str()) == 0;
+      }
+    }
+#endif
+    base = nullptr;
+    mappedSize = 0;
+    slotMask = 0;
+    count = 0;
+    writable = false;
+    return ok;
+  }
+
+  size_t size() const { return (size_t)count; }
+  size_t capacity() const { return base ? (size_t)(slotMask + 1) : 0; }
+  size_t fileSize() const { return mappedSize; }
+
+private:
+  static constexpr char MAGIC[8] = {'S', 'D', 'X', 'S', 'T', 'O', 'R', 'E'};
+
+  struct Header {
+    char magic[8];
+    uint32_t version;
+    uint32_t slotSize;
+    uint64_t slotCount;
+    uint64_t entries;
+  };
+
+  struct Slot {
+    uint32_t tag;           // 0 = empty
+    uint8_t givens[11];     // bit i = cell i is a given
+    uint8_t tier;
+    uint16_t rating;
+    uint8_t solution[41];   // digit of cell i in nibble i (low nibble first)
+    uint8_t reserved[5];
+  };
+  static_assert(sizeof(Slot) == 64, "a slot is one cache line");
+
+  Header *header() const { return (Header *)base; }
+  Slot *slots() const { return (Slot *)(base + HEADER_SIZE); }
+
+  // The puzzle packed like a slot: givens bitmap and digits as nibbles (0 = empty), with
+  // its hash, a non-zero tag from the high half and the table position from the low half.
+  struct Key {
+    uint8_t givens[11];
+    uint8_t digits[48];  // 41 used, zero padded to whole words
+    uint8_t mask[48];    // 0xF nibble for every given
+    uint64_t hash;
+    uint32_t tag;
+
+    explicit Key(const char *in81) {
+      std::memset(this, 0, sizeof(*this));
+      for (int i = 0; i < 81; i++) {
+        const int d = in81[i] - '0';
+        if (d >= 1 && d <= 9) {
+          givens[i >> 3] |= (uint8_t)(1u << (i & 7));
+          digits[i >> 1] |= (uint8_t)(d << ((i & 1) * 4));
+          mask[i >> 1] |= (uint8_t)(0xF << ((i & 1) * 4));
+        }
+      }
+      uint64_t h = 0x243F6A8885A308D3ull;
+      for (int w = 0; w < 48; w += 8) {
+        uint64_t word;
+        std::memcpy(&word, digits + w, 8);
+        h = (h ^ word) * 0x9E3779B97F4A7C15ull;
+        h ^= h >> 29;
+      }
+      h ^= h >> 32;
+      h *= 0xD6E8FEB86659FD93ull;
+      h ^= h >> 32;
+      hash = h;
+      tag = (uint32_t)(h >> 32) | 1u;
+    }
+
+    // Same givens, and the solution holds the puzzle's digits on them.
+    bool matches(const Slot &slot) const {
+      if (slot.tag != tag || std::memcmp(slot.givens, givens, sizeof(givens)) != 0) {
+        return false;
+      }
+      uint64_t diff = 0;
+      for (int w = 0; w < 40; w += 8) {
+        uint64_t s;
+        uint64_t d;
+        uint64_t m;
+        std::memcpy(&s, slot.solution + w, 8);
+        std::memcpy(&d, digits + w, 8);
+        std::memcpy(&m, mask + w, 8);
+        diff |= (s & m) ^ d;
+      }
+      diff |= (uint64_t)((slot.solution[40] & mask[40]) ^ digits[40]);
+      return diff == 0;
+    }
+  };
+
+  uint8_t *base = nullptr;
+  size_t mappedSize = 0;
+  uint64_t slotMask = 0;
+  uint64_t count = 0;
+  bool writable = false;
+  std::string finalPath;
+  std::string tmpPath;
+};
+
+#endif // SOLUTION_STORE_H
@@ -0,0 +1,235 @@
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "solver.hpp"
+#include "batch_checkpoint.hpp"
+
+// Batch difficulty classifier: lowest technique tier that solves each puzzle.
+//
+// The whole batch is run with singles only first. Puzzles still unsolved keep
+// their stalled board (values + candidates) and only those are run again with
+// the next tier, starting from where they stopped, and so on up to
+// SUDORIX_TIER_MAX. Whatever is left is reported as unsolved (tier 0).
+//
+// The input is streamed in blocks of --block puzzles, each classified tier by tier.
+// With --checkpoint=DIR every block is committed to DIR (output chunk + input offset
+// + histogram so far, see batch_checkpoint.hpp), and running the same command again
+// resumes after the last committed block.
+
+struct ClassifyItem {
+  size_t lineNo;
+  std::string in81;
+  uint8_t values[81];
+  uint16_t cands[81];
+  uint32_t tier;  // 0 = not solved (yet)
+};
+
+static const char *tierName(uint32_t tier) {
+  switch (tier) {
+    case SUDORIX_TIER_SINGLES:       return "singles";
+    case SUDORIX_TIER_INTERSECTIONS: return "intersections";
+    default:                         return "unsolved";
+  }
+}
+
+static bool isSolved(const uint8_t values[81]) {
+  for (int i = 0; i < 81; i++) {
+    if (values[i] == 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static bool loadPuzzle(const std::string &line, std::string *in81) {
+  std::string compact;
+  for (char c : line) {
+    if (c == '.' || (c >= '0' && c <= '9')) {
+      compact.push_back(c);
+    } else if (c == '#') {
+      break;
+    }
+  }
+  if (compact.size() != 81) {
+    return false;
+  }
+  *in81 = compact;
+  return true;
+}
+
+static void usage(const char *argv0) {
+  std::cerr
+      << "Usage: " << argv0 << " <sudoku_file.txt> [--summary] [--block=N] [--checkpoint=DIR]\n"
+      << "  Prints '<puzzle> <tier> <name>' per puzzle, then a histogram of tiers.\n"
+      << "  --summary  print only the histogram\n"
+      << "  --block=N  puzzles read and classified at a time (default 65536)\n"
+      << "  --checkpoint=DIR  commit every block to DIR (per-puzzle lines go to DIR/out.NNNNNN);\n"
+      << "             the same command resumes after the last committed block\n";
+}
+
+int main(int argc, char **argv) {
+  if (argc < 2) {
+    usage(argv[0]);
+    return 2;
+  }
+
+  std::string path = argv[1];
+  bool summaryOnly = false;
+  size_t blockSize = 65536;
+  std::string checkpointDir;
+  for (int i = 2; i < argc; i++) {
+    std::string a = argv[i];
+    if (a == "--summary") {
+      summaryOnly = true;
+    } else if (a.rfind("--block=", 0) == 0) {
+      blockSize = std::max<size_t>(1, (size_t)std::strtoul(a.c_str() + std::strlen("--block="), nullptr, 10));
+    } else if (a.rfind("--checkpoint=", 0) == 0) {
+      checkpointDir = a.substr(std::strlen("--checkpoint="));
+    } else {
+      std::cerr << "Unknown option: " << a << "\n";
+      usage(argv[0]);
+      return 2;
+    }
+  }
+
+  std::ifstream fin(path);
+  if (!fin) {
+    std::cerr << "Failed to open file: " << path << "\n";
+    return 2;
+  }
+
+  // totals, kept in the checkpoint between runs: then per tier the puzzles it solved,
+  // the puzzles it ran on and the time it took
+  enum { TOTAL, INVALID, PER_TIER };
+  const size_t tiers = SUDORIX_TIER_MAX + 1;
+  std::vector<uint64_t> totals(PER_TIER + 3 * tiers, 0);
+  uint64_t *histogram = &totals[PER_TIER];
+  uint64_t *tierRuns = &totals[PER_TIER + tiers];
+  uint64_t *tierNs = &totals[PER_TIER + 2 * tiers];
+  uint64_t lineNo = 0;
+  bool finished = false;
+  BatchCheckpoint checkpoint;
+  if (!checkpointDir.empty()) {
+    const std::string job = "classify " + path + " " + std::to_string(BatchCheckpoint::fileSize(path)) +
+                            (summaryOnly ? " summary" : "");
+    std::string err;
+    if (!checkpoint.open(checkpointDir, job, totals.size(), &err)) {
+      std::cerr << "Checkpoint " << checkpointDir << ": " << err << "\n";
+      return 2;
+    }
+    if (checkpoint.resumed()) {
+      totals = checkpoint.counters();
+      histogram = &totals[PER_TIER];
+      tierRuns = &totals[PER_TIER + tiers];
+      tierNs = &totals[PER_TIER + 2 * tiers];
+      lineNo = checkpoint.lineNo();
+      finished = checkpoint.finished();
+      fin.seekg((std::streamoff)checkpoint.offset());
+      std::cerr << "Resuming at line " << lineNo + 1 << " (" << checkpoint.chunks() << " blocks done)\n";
+    }
+  }
+
+  std::vector<ClassifyItem> items;
+  std::vector<ClassifyItem *> pending;
+  std::vector<ClassifyItem *> stalled;
+  std::string line;
+  std::string output;
+  while (!finished) {
+    items.clear();
+    bool atEnd = false;
+    while (items.size() < blockSize) {
+      if (!std::getline(fin, line)) {
+        atEnd = true;
+        break;
+      }
+      lineNo++;
+      ClassifyItem item;
+      if (!loadPuzzle(line, &item.in81)) {
+        continue;
+      }
+      item.lineNo = lineNo;
+      item.tier = 0;
+      if (!sudorix_solver_parse_board(item.in81.c_str(), item.values, item.cands)) {
+        totals[INVALID]++;
+        std::cerr << "line " << lineNo << ": invalid puzzle\n";
+        continue;
+      }
+      items.push_back(item);
+    }
+
+    // Tier by tier, over the puzzles the previous tiers left unsolved.
+    pending.clear();
+    for (ClassifyItem &item : items) {
+      pending.push_back(&item);
+    }
+    for (uint32_t tier = SUDORIX_TIER_SINGLES; tier <= SUDORIX_TIER_MAX && !pending.empty(); tier++) {
+      stalled.clear();
+      const auto t0 = std::chrono::steady_clock::now();
+      for (ClassifyItem *item : pending) {
+        sudorix_solver_run_tier(item->values, item->cands, tier);
+        if (isSolved(item->values)) {
+          item->tier = tier;
+          histogram[tier]++;
+        } else {
+          stalled.push_back(item);
+        }
+      }
+      const auto t1 = std::chrono::steady_clock::now();
+      tierNs[tier] += (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count();
+      tierRuns[tier] += pending.size();
+      pending.swap(stalled);
+    }
+    histogram[0] += pending.size();
+    totals[TOTAL] += items.size();
+
+    output.clear();
+    if (!summaryOnly) {
+      for (const ClassifyItem &item : items) {
+        output += item.in81 + " " + std::to_string(item.tier) + " " + tierName(item.tier) + "\n";
+      }
+    }
+    if (checkpointDir.empty()) {
+      std::cout << output;
+    } else {
+      const uint64_t offset = atEnd ? BatchCheckpoint::fileSize(path) : (uint64_t)fin.tellg();
+      checkpoint.counters() = totals;
+      if (!checkpoint.commit(output, offset, lineNo, atEnd)) {
+        std::cerr << "Failed to write checkpoint: " << checkpointDir << "\n";
+        return 2;
+      }
+    }
+    finished = atEnd;
+  }
+  if (!summaryOnly && checkpointDir.empty()) {
+    std::cout << "\n";
+  }
+
+  std::cout << std::left << std::setw(16) << "Tier"
+            << std::right << std::setw(10) << "puzzles" << std::setw(9) << "share"
+            << std::setw(10) << "runs" << std::setw(12) << "ms" << "\n"
+            << std::string(57, '-') << "\n";
+  for (uint32_t tier = SUDORIX_TIER_SINGLES; tier <= SUDORIX_TIER_MAX + 1; tier++) {
+    const uint32_t t = (tier > SUDORIX_TIER_MAX) ? 0 : tier;
+    std::cout << std::left << std::setw(16) << (std::to_string(t) + " " + tierName(t))
+              << std::right << std::setw(10) << histogram[t]
+              << std::setw(8) << std::fixed << std::setprecision(1)
+              << (totals[TOTAL] == 0 ? 0.0 : 100.0 * (double)histogram[t] / (double)totals[TOTAL]) << "%";
+    if (t != 0) {
+      std::cout << std::setw(10) << tierRuns[t] << std::setw(12) << std::setprecision(1) << (double)tierNs[t] * 1e-6;
+    }
+    std::cout << "\n";
+  }
+  std::cout << "\nCLASSIFY: total=" << totals[TOTAL] << " invalid=" << totals[INVALID] << "\n";
+
+  return 0;
+}
@@ -0,0 +1,301 @@
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "solver.hpp"
+#include "MaskBoard.hpp"
+#include "job_pool.hpp"
+#include "batch_checkpoint.hpp"
+
+// Batch minimality checker: does each puzzle have a unique solution, and is every
+// given necessary for it?
+//
+// Each puzzle goes through sudorix_solver_minimality, sharded over worker threads
+// like the test runner. --naive checks the same puzzles the textbook way instead
+// (count up to two solutions of every puzzle with one given removed, from scratch),
+// as a reference for the results and the timing.
+//
+// The input is streamed in blocks of --block puzzles. With --checkpoint=DIR every block
+// is committed to DIR (output chunk + input offset + totals so far, see
+// batch_checkpoint.hpp), and running the same command again resumes after the last
+// committed block.
+
+struct MinimalityItem {
+  size_t lineNo;
+  std::string in81;
+  uint32_t solutions;  // 0, 1, 2 = two or more
+  uint32_t givens;
+  std::vector<uint32_t> redundant;
+  bool invalid;
+};
+
+static bool loadPuzzle(const std::string &line, std::string *in81) {
+  std::string compact;
+  for (char c : line) {
+    if (c == '.' || (c >= '0' && c <= '9')) {
+      compact.push_back(c);
+    } else if (c == '#') {
+      break;
+    }
+  }
+  if (compact.size() != 81) {
+    return false;
+  }
+  *in81 = compact;
+  return true;
+}
+
+static void checkOne(MinimalityItem &item) {
+  uint32_t out[3 + 81];
+  item.invalid = !sudorix_solver_minimality(item.in81.c_str(), out, 3 + 81);
+  if (item.invalid) {
+    return;
+  }
+  item.solutions = out[0];
+  item.givens = out[1];
+  item.redundant.assign(out + 3, out + 3 + out[2]);
+}
+
+static void checkOneNaive(MinimalityItem &item) {
+  Digit givens[81];
+  for (int i = 0; i < 81; i++) {
+    const char c = item.in81[i];
+    givens[i] = (c >= '1' && c <= '9') ? (Digit)(c - '0') : 0;
+  }
+  const auto countSolutions = [](const Digit values[81]) {
+    MaskBoard board;
+    if (!board.init(values)) {
+      return -1;
+    }
+    return board.propagate() ? board.countSolutions(2) : 0;
+  };
+
+  const int solutions = countSolutions(givens);
+  item.invalid = solutions < 0;
+  if (item.invalid) {
+    return;
+  }
+  item.solutions = (uint32_t)solutions;
+  item.givens = 0;
+  item.redundant.clear();
+  for (int g = 0; g < 81; g++) {
+    if (givens[g] == 0) {
+      continue;
+    }
+    item.givens++;
+    if (solutions != 1) {
+      continue;
+    }
+    const Digit v = givens[g];
+    givens[g] = 0;
+    if (countSolutions(givens) == 1) {
+      item.redundant.push_back((uint32_t)g);
+    }
+    givens[g] = v;
+  }
+}
+
+static void usage(const char *argv0) {
+  std::cerr
+      << "Usage: " << argv0 << " <sudoku_file.txt> [--jobs=N] [--chunk=N] [--pin] [--naive] [--summary]\n"
+      << "         [--block=N] [--checkpoint=DIR]\n"
+      << "  Prints '<puzzle> minimal', '<puzzle> redundant=<cells>' or '<puzzle> solutions=0|2+'\n"
+      << "  per puzzle, then the totals.\n"
+      << "  --jobs=N   shard the puzzles over N worker threads (0 = hardware concurrency)\n"
+      << "  --chunk=N  puzzles handed to a worker at a time (default 64)\n"
+      << "  --pin      pin each worker thread to its own CPU (Linux)\n"
+      << "  --naive    count the solutions of every removal from scratch (reference)\n"
+      << "  --summary  print only the totals\n"
+      << "  --block=N  puzzles read and checked at a time (default 65536)\n"
+      << "  --checkpoint=DIR  commit every block to DIR (per-puzzle lines go to DIR/out.NNNNNN);\n"
+      << "             the same command resumes after the last committed block\n";
+}
+
+int main(int argc, char **argv) {
+  if (argc < 2) {
+    usage(argv[0]);
+    return 2;
+  }
+
+  std::string path = argv[1];
+  bool summaryOnly = false;
+  bool naive = false;
+  bool pinWorkers = false;
+  unsigned jobs = 1;
+  size_t chunkSize = 64;
+  size_t blockSize = 65536;
+  std::string checkpointDir;
+  for (int i = 2; i < argc; i++) {
+    std::string a = argv[i];
+    if (a == "--summary") {
+      summaryOnly = true;
+    } else if (a == "--naive") {
+      naive = true;
+    } else if (a == "--pin") {
+      pinWorkers = true;
+    } else if (a.rfind("--jobs=", 0) == 0) {
+      jobs = (unsigned)std::strtoul(a.c_str() + std::strlen("--jobs="), nullptr, 10);
+      if (jobs == 0) {
+        jobs = std::max(1u, std::thread::hardware_concurrency());
+      }
+    } else if (a.rfind("--chunk=", 0) == 0) {
+      chunkSize = std::max<size_t>(1, (size_t)std::strtoul(a.c_str() + std::strlen("--chunk="), nullptr, 10));
+    } else if (a.rfind("--block=", 0) == 0) {
+      blockSize = std::max<size_t>(1, (size_t)std::strtoul(a.c_str() + std::strlen("--block="), nullptr, 10));
+    } else if (a.rfind("--checkpoint=", 0) == 0) {
+      checkpointDir = a.substr(std::strlen("--checkpoint="));
+    } else {
+      std::cerr << "Unknown option: " << a << "\n";
+      usage(argv[0]);
+      return 2;
+    }
+  }
+
+  std::ifstream fin(path);
+  if (!fin) {
+    std::cerr << "Failed to open file: " << path << "\n";
+    return 2;
+  }
+
+  // totals, kept in the checkpoint between runs
+  enum { TOTAL, INVALID, MINIMAL, NOT_MINIMAL, NOT_UNIQUE, REDUNDANT_GIVENS, GIVENS, CHECK_NS, COUNTERS };
+  std::vector<uint64_t> totals(COUNTERS, 0);
+  uint64_t lineNo = 0;
+  bool finished = false;
+  BatchCheckpoint checkpoint;
+  if (!checkpointDir.empty()) {
+    // --summary only changes what reaches the chunks, so it is part of the job too
+    const std::string job = "minimality " + path + " " + std::to_string(BatchCheckpoint::fileSize(path)) +
+                            (naive ? " naive" : "") + (summaryOnly ? " summary" : "");
+    std::string err;
+    if (!checkpoint.open(checkpointDir, job, COUNTERS, &err)) {
+      std::cerr << "Checkpoint " << checkpointDir << ": " << err << "\n";
+      return 2;
+    }
+    if (checkpoint.resumed()) {
+      totals = checkpoint.counters();
+      lineNo = checkpoint.lineNo();
+      finished = checkpoint.finished();
+      fin.seekg((std::streamoff)checkpoint.offset());
+      std::cerr << "Resuming at line " << lineNo + 1 << " (" << checkpoint.chunks() << " blocks done)\n";
+    }
+  }
+
+  const auto checkRange = [&](std::vector<MinimalityItem> &items, size_t begin, size_t end) {
+    for (size_t i = begin; i < end; i++) {
+      if (naive) {
+        checkOneNaive(items[i]);
+      } else {
+        checkOne(items[i]);
+      }
+    }
+  };
+
+  std::unique_ptr<JobPool> pool;
+  if (jobs > 1) {
+    pool.reset(new JobPool(jobs, pinWorkers));
+  }
+  std::vector<MinimalityItem> items;
+  std::string line;
+  std::string output;
+  while (!finished) {
+    items.clear();
+    bool atEnd = false;
+    while (items.size() < blockSize) {
+      if (!std::getline(fin, line)) {
+        atEnd = true;
+        break;
+      }
+      lineNo++;
+      MinimalityItem item;
+      if (!loadPuzzle(line, &item.in81)) {
+        continue;
+      }
+      item.lineNo = lineNo;
+      item.solutions = 0;
+      item.givens = 0;
+      item.invalid = false;
+      items.push_back(std::move(item));
+    }
+
+    const auto t0 = std::chrono::steady_clock::now();
+    if (!pool) {
+      checkRange(items, 0, items.size());
+    } else {
+      pool->run(items.size(), chunkSize, [&](size_t begin, size_t end) { checkRange(items, begin, end); });
+    }
+    totals[CHECK_NS] += (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+                            std::chrono::steady_clock::now() - t0).count();
+
+    output.clear();
+    for (const MinimalityItem &item : items) {
+      totals[TOTAL]++;
+      if (item.invalid) {
+        totals[INVALID]++;
+        std::cerr << "line " << item.lineNo << ": invalid puzzle\n";
+        continue;
+      }
+      totals[GIVENS] += item.givens;
+      if (item.solutions != 1) {
+        totals[NOT_UNIQUE]++;
+      } else if (item.redundant.empty()) {
+        totals[MINIMAL]++;
+      } else {
+        totals[NOT_MINIMAL]++;
+        totals[REDUNDANT_GIVENS] += item.redundant.size();
+      }
+      if (summaryOnly) {
+        continue;
+      }
+
+      output += item.in81;
+      if (item.solutions == 0) {
+        output += " solutions=0\n";
+      } else if (item.solutions > 1) {
+        output += " solutions=2+\n";
+      } else if (item.redundant.empty()) {
+        output += " minimal\n";
+      } else {
+        output += " redundant=";
+        for (size_t k = 0; k < item.redundant.size(); k++) {
+          output += (k ? "," : "") + std::to_string(item.redundant[k]);
+        }
+        output += "\n";
+      }
+    }
+
+    if (checkpointDir.empty()) {
+      std::cout << output;
+    } else {
+      const uint64_t offset = atEnd ? BatchCheckpoint::fileSize(path) : (uint64_t)fin.tellg();
+      checkpoint.counters() = totals;
+      if (!checkpoint.commit(output, offset, lineNo, atEnd)) {
+        std::cerr << "Failed to write checkpoint: " << checkpointDir << "\n";
+        return 2;
+      }
+    }
+    finished = atEnd;
+  }
+
+  const double seconds = (double)totals[CHECK_NS] * 1e-9;
+  const uint64_t checked = totals[TOTAL] - totals[INVALID];
+  std::cout << "MINIMALITY: total=" << totals[TOTAL] << " invalid=" << totals[INVALID]
+            << " minimal=" << totals[MINIMAL] << " not_minimal=" << totals[NOT_MINIMAL]
+            << " not_unique=" << totals[NOT_UNIQUE] << " redundant_givens=" << totals[REDUNDANT_GIVENS]
+            << " givens=" << totals[GIVENS] << "\n";
+  std::printf("RATE: seconds=%.3f puzzles_per_sec=%.1f us_per_puzzle=%.2f\n", seconds,
+              seconds > 0 ? (double)checked / seconds : 0.0,
+              checked ? seconds * 1e6 / (double)checked : 0.0);
+
+  return 0;
+}
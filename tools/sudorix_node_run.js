@@ -0,0 +1,256 @@
+#!/usr/bin/env node
+/* =========================================================
+ * Sudorix - Node runner for the WASM solver
+ *
+ * Streams a puzzle file (one puzzle per line, 81 chars, 0-9 or '.')
+ * through the node build of the solver (make wasm-node) and checks every
+ * result like the native test runner, with the same output format, so
+ * the two can be diffed on identical inputs.
+ *
+ * Usage:
+ *   node tools/sudorix_node_run.js <solver_wasm_node.js> <puzzles.txt>
+ *        [--mode=full|batch] [--batch=N] [--limit=N] [--summary]
+ * ========================================================= */
+"use strict";
+
+const fs = require("fs");
+const path = require("path");
+const readline = require("readline");
+
+function usage() {
+  process.stderr.write(
+    "Usage: node sudorix_node_run.js <solver_wasm_node.js> <puzzles.txt> [options]\n" +
+    "  --mode=full  solve each puzzle with sudorix_solver_full (default)\n" +
+    "  --mode=batch solve --batch=N puzzles per sudorix_solver_full_batch call (default 256)\n" +
+    "  --limit=N    stop after N puzzles\n" +
+    "  --summary    print only the final summary\n");
+}
+
+/* ---- input lines, as normalize81 in the native runner ---- */
+function normalize81(line) {
+  const s = line.trim();
+  if (s === "" || s[0] === "#") {
+    return { skip: true };
+  }
+  const compact = s.replace(/[ \t]/g, "");
+  if (compact.length !== 81) {
+    return { err: `Expected 81 chars, got ${compact.length}`, text: s };
+  }
+  if (!/^[0-9.]{81}$/.test(compact)) {
+    return { err: "Invalid character (allowed: 0-9 or .)", text: s };
+  }
+  return { in81: compact.replace(/\./g, "0") };
+}
+
+/* ---- result check, as validateSolution in the native runner ---- */
+const UNITS = [];
+for (let u = 0; u < 9; u++) {
+  const row = [];
+  const col = [];
+  const box = [];
+  for (let k = 0; k < 9; k++) {
+    row.push(u * 9 + k);
+    col.push(k * 9 + u);
+    box.push((Math.floor(u / 3) * 3 + Math.floor(k / 3)) * 9 + (u % 3) * 3 + (k % 3));
+  }
+  UNITS.push(["Row", u, row], ["Col", u, col], ["Box", u, box]);
+}
+
+function validateSolution(in81, out81) {
+  if (out81.length !== 81) {
+    return "Output length != 81";
+  }
+  for (let i = 0; i < 81; i++) {
+    const c = in81[i];
+    if (c >= "1" && c <= "9" && out81[i] !== c) {
+      return `Given mismatch at idx=${i} (in=${c}, out=${out81[i]})`;
+    }
+  }
+  for (const [label, u, idxs] of UNITS) {
+    let seen = 0;
+    for (const idx of idxs) {
+      const c = out81[idx];
+      if (c < "1" || c > "9") {
+        return `${label} ${u} invalid: Non-digit in solution at idx=${idx} ('${c}')`;
+      }
+      const bit = 1 << (c.charCodeAt(0) - 49);
+      if (seen & bit) {
+        return `${label} ${u} invalid: Duplicate digit ${c} in unit`;
+      }
+      seen |= bit;
+    }
+  }
+  return null;
+}
+
+/* ---- solver bridge ---- */
+function makeSolver(wasm, batchSize) {
+  const solveFull = wasm.cwrap("sudorix_solver_full", "number", ["number", "number"]);
+  const solveBatch = wasm.cwrap("sudorix_solver_full_batch", "number", ["number", "number", "number"]);
+  const inPtr = wasm._malloc(batchSize * 81);
+  const outPtr = wasm._malloc(batchSize * 81 + 1);
+  const strPtr = wasm._malloc(82);  // char[81] + '\0' for sudorix_solver_full
+  const decoder = new TextDecoder("latin1");
+
+  const put = (ptr, s) => {
+    const heap = wasm.HEAPU8;
+    for (let i = 0; i < 81; i++) {
+      heap[ptr + i] = s.charCodeAt(i);
+    }
+  };
+  // HEAPU8 is re-read after every call: memory growth replaces the buffer
+  const get = (ptr) => decoder.decode(wasm.HEAPU8.subarray(ptr, ptr + 81));
+
+  // in81s: array of 81-char strings; returns the solved strings (null entries on failure)
+  return function solve(in81s, useBatch) {
+    const n = in81s.length;
+    const out = new Array(n).fill(null);
+
+    if (useBatch) {
+      for (let k = 0; k < n; k++) {
+        put(inPtr + k * 81, in81s[k]);
+      }
+      if (solveBatch(inPtr, outPtr, n)) {
+        for (let k = 0; k < n; k++) {
+          out[k] = get(outPtr + k * 81);
+        }
+      }
+      return out;
+    }
+
+    for (let k = 0; k < n; k++) {
+      put(strPtr, in81s[k]);
+      wasm.HEAPU8[strPtr + 81] = 0;
+      if (solveFull(strPtr, outPtr)) {
+        out[k] = get(outPtr);
+      }
+    }
+    return out;
+  };
+}
+
+async function main() {
+  const positional = [];
+  let mode = "full";
+  let batchSize = 256;
+  let limit = Infinity;
+  let summaryOnly = false;
+
+  for (const a of process.argv.slice(2)) {
+    if (a.startsWith("--mode=")) {
+      mode = a.slice("--mode=".length);
+    } else if (a.startsWith("--batch=")) {
+      batchSize = Math.max(1, parseInt(a.slice("--batch=".length), 10) || 1);
+    } else if (a.startsWith("--limit=")) {
+      limit = parseInt(a.slice("--limit=".length), 10);
+    } else if (a === "--summary") {
+      summaryOnly = true;
+    } else if (a.startsWith("--")) {
+      process.stderr.write(`Unknown option: ${a}\n`);
+      usage();
+      return 2;
+    } else {
+      positional.push(a);
+    }
+  }
+
+  if (positional.length !== 2 || (mode !== "full" && mode !== "batch")) {
+    usage();
+    return 2;
+  }
+
+  const createSudorixSolver = require(path.resolve(positional[0]));
+  const wasm = await createSudorixSolver();
+  // full mode solves one puzzle per call but reads the file in groups all the same
+  const solve = makeSolver(wasm, batchSize);
+  const useBatch = mode === "batch";
+
+  let total = 0;
+  let passed = 0;
+  let failed = 0;
+  let solveNs = 0n;
+  const out = [];
+
+  const flush = (group) => {
+    // timed like the native runner: solving and checking, not reading or printing
+    const t0 = process.hrtime.bigint();
+    const valid = group.filter((e) => e.in81);
+    const results = solve(valid.map((e) => e.in81), useBatch);
+
+    let k = 0;
+    for (const e of group) {
+      total++;
+      let out81 = null;
+      let why = e.err;
+      if (e.in81) {
+        out81 = results[k++];
+        why = out81 === null
+          ? (useBatch ? "sudorix_solver_full_batch returned 0 (failure)" : "sudorix_solver_full returned 0 (failure)")
+          : validateSolution(e.in81, out81);
+      }
+      if (why) {
+        failed++;
+      } else {
+        passed++;
+      }
+      if (summaryOnly) {
+        continue;
+      }
+      if (!e.in81) {
+        out.push(`[#${total} line ${e.lineNo}] INPUT: ${e.text}\nOUTPUT: (n/a)\nRESULT: FAILED (${why})\n\n`);
+      } else {
+        out.push(`[#${total} line ${e.lineNo}] \nINPUT:  ${e.in81}\nOUTPUT: ${out81 || ".".repeat(81)}\n` +
+                 (why ? `RESULT: FAILED (${why})\n\n` : "RESULT: PASSED\n\n"));
+      }
+    }
+    solveNs += process.hrtime.bigint() - t0;
+    if (out.length) {
+      process.stdout.write(out.join(""));
+      out.length = 0;
+    }
+  };
+
+  const rl = readline.createInterface({ input: fs.createReadStream(positional[1]), crlfDelay: Infinity });
+  let group = [];
+  let lineNo = 0;
+  let count = 0;
+  for await (const line of rl) {
+    lineNo++;
+    const e = normalize81(line);
+    if (e.skip) {
+      continue;
+    }
+    if (count++ >= limit) {
+      break;
+    }
+    e.lineNo = lineNo;
+    group.push(e);
+    if (group.length === batchSize) {
+      flush(group);
+      group = [];
+    }
+  }
+  if (group.length) {
+    flush(group);
+  }
+  rl.close();
+
+  const seconds = Number(solveNs) / 1e9;
+  process.stdout.write(`SUMMARY: total=${total} passed=${passed} failed=${failed}\n`);
+  process.stdout.write(`RATE: seconds=${seconds.toFixed(3)} puzzles_per_sec=` +
+                       `${(seconds > 0 ? total / seconds : 0).toFixed(1)}\n`);
+  return 0;
+}
+
+// output piped into e.g. head: stop quietly
+process.stdout.on("error", (e) => {
+  if (e.code === "EPIPE") {
+    process.exit(0);
+  }
+  throw e;
+});
+
+main().then((rc) => { process.exitCode = rc; }, (e) => {
+  process.stderr.write(`Error: ${e && e.stack ? e.stack : String(e)}\n`);
+  process.exitCode = 2;
+});
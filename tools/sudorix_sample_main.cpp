@@ -0,0 +1,289 @@
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "GridSampler.hpp"
+
+// Random solved grid sampler: prints grids from GridSampler, one per line,
+// and the sampling rate.
+//
+// --check runs the bias tests instead of printing grids:
+//   - validity of every grid;
+//   - cells: digit counts per cell against 1/9 (chi-square, 648 degrees of freedom);
+//   - pairs: cells equal in consecutive grids against 1/9 (the chain must not
+//     show through the symmetry step);
+//   - structure: the mean of a statistic the symmetries leave unchanged (number of
+//     rectangles, i.e. 4 cells on two rows, two columns and two boxes holding two
+//     digits crosswise), against its uniform mean estimated by importance sampling:
+//     independent random fills, each weighted by 1/q. Consecutive grids of the chain
+//     are correlated, so the error of its mean comes from CHECK_BATCHES batch means.
+// Scores are reported as z values; |z| > CHECK_Z_LIMIT fails (exit code 1).
+// The structure test is also printed for the unweighted fills, for comparison only:
+// that is what a plain random fill (or backtracking) would give.
+
+static constexpr double CHECK_Z_LIMIT = 5.0;
+static constexpr size_t CHECK_BATCHES = 100;
+
+static bool validGrid(const Digit grid[81]) {
+  for (int u = 0; u < 9; u++) {
+    Mask row = 0;
+    Mask col = 0;
+    Mask box = 0;
+    for (int k = 0; k < 9; k++) {
+      row |= digitToBit(grid[ROW_CELLS[u][k]]);
+      col |= digitToBit(grid[COL_CELLS[u][k]]);
+      box |= digitToBit(grid[BOX_CELLS[u][k]]);
+    }
+    if (row != 0x1FF || col != 0x1FF || box != 0x1FF) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Rectangles: rows r1, r2 and columns c1, c2 spanning exactly two boxes, with
+// grid[r1][c1] == grid[r2][c2] and grid[r1][c2] == grid[r2][c1].
+static int countRectangles(const Digit grid[81]) {
+  int n = 0;
+  for (int r1 = 0; r1 < 9; r1++) {
+    for (int r2 = r1 + 1; r2 < 9; r2++) {
+      const bool sameBand = (r1 / 3) == (r2 / 3);
+      for (int c1 = 0; c1 < 9; c1++) {
+        for (int c2 = c1 + 1; c2 < 9; c2++) {
+          if (sameBand == ((c1 / 3) == (c2 / 3))) {
+            continue;  // one box or four boxes
+          }
+          if (grid[r1 * 9 + c1] == grid[r2 * 9 + c2] && grid[r1 * 9 + c2] == grid[r2 * 9 + c1]) {
+            n++;
+          }
+        }
+      }
+    }
+  }
+  return n;
+}
+
+// Wilson-Hilferty: chi-square with k degrees of freedom to a standard normal score.
+static double chiSquareZ(double chi2, double k) {
+  const double v = 2.0 / (9.0 * k);
+  return (std::cbrt(chi2 / k) - (1.0 - v)) / std::sqrt(v);
+}
+
+struct MeanEstimate {
+  double mean;
+  double variance;  // of the mean
+};
+
+// Mean of independent samples.
+static MeanEstimate sampleMean(const std::vector<int> &xs) {
+  double sum = 0;
+  double sumSq = 0;
+  for (int x : xs) {
+    sum += x;
+    sumSq += (double)x * x;
+  }
+  const double n = (double)xs.size();
+  const double mean = sum / n;
+  return {mean, (sumSq / n - mean * mean) / (n - 1)};
+}
+
+// Self-normalized importance sampling mean, weights given as logarithms.
+static MeanEstimate weightedMean(const std::vector<int> &xs, const std::vector<double> &logWeights) {
+  double top = logWeights[0];
+  for (double lw : logWeights) {
+    top = std::max(top, lw);
+  }
+  double sumW = 0;
+  double sumWX = 0;
+  for (size_t i = 0; i < xs.size(); i++) {
+    const double w = std::exp(logWeights[i] - top);
+    sumW += w;
+    sumWX += w * xs[i];
+  }
+  const double mean = sumWX / sumW;
+  double var = 0;
+  for (size_t i = 0; i < xs.size(); i++) {
+    const double w = std::exp(logWeights[i] - top) / sumW;
+    var += w * w * (xs[i] - mean) * (xs[i] - mean);
+  }
+  return {mean, var};
+}
+
+// Mean of a correlated series, with the variance of the batch means.
+static MeanEstimate batchMean(const std::vector<int> &xs, size_t batches) {
+  const size_t len = xs.size() / batches;
+  std::vector<int> sums(batches, 0);
+  for (size_t b = 0; b < batches; b++) {
+    for (size_t k = 0; k < len; k++) {
+      sums[b] += xs[b * len + k];
+    }
+  }
+  const MeanEstimate m = sampleMean(sums);
+  return {m.mean / (double)len, m.variance / ((double)len * len)};
+}
+
+static double meanZ(const MeanEstimate &a, const MeanEstimate &b) {
+  return (a.mean - b.mean) / std::sqrt(a.variance + b.variance);
+}
+
+static bool report(const char *name, double z, const char *detail) {
+  const bool ok = std::fabs(z) <= CHECK_Z_LIMIT;
+  std::printf("CHECK: %-10s z=%7.2f %s %s\n", name, z, ok ? "PASSED" : "FAILED", detail);
+  return ok;
+}
+
+static int runCheck(uint64_t seed, size_t count, int swaps, int jumpEvery) {
+  GridSampler sampler(seed, swaps, jumpEvery);
+  Digit grid[81];
+  Digit prev[81] = {};
+  std::vector<double> cellCounts(81 * 9, 0.0);
+  std::vector<int> rects(count);
+  size_t invalid = 0;
+  size_t equalCells = 0;
+  for (size_t n = 0; n < count; n++) {
+    sampler.next(grid);
+    if (!validGrid(grid)) {
+      invalid++;
+    }
+    for (int i = 0; i < 81; i++) {
+      cellCounts[i * 9 + grid[i] - 1] += 1.0;
+      equalCells += (n > 0 && grid[i] == prev[i]) ? 1 : 0;
+      prev[i] = grid[i];
+    }
+    rects[n] = countRectangles(grid);
+  }
+
+  // reference: independent random fills
+  const size_t refCount = count / 4 + 2;
+  std::vector<int> refRects;
+  std::vector<double> refLogWeights;
+  SudorixRng refRng(seed ^ 0xB7E151628AED2A6Bull);
+  while (refRects.size() < refCount) {
+    const double logWeight = GridSampler::randomFill(refRng, grid);
+    if (logWeight >= 0) {
+      refRects.push_back(countRectangles(grid));
+      refLogWeights.push_back(logWeight);
+    }
+  }
+
+  const double expected = (double)count / 9.0;
+  double chi2 = 0;
+  for (double c : cellCounts) {
+    chi2 += (c - expected) * (c - expected) / expected;
+  }
+  const double pairs = (double)(count - 1) * 81.0;
+  const double equalZ = ((double)equalCells - pairs / 9.0) / std::sqrt(pairs * (1.0 / 9.0) * (8.0 / 9.0));
+  const MeanEstimate sampled = batchMean(rects, CHECK_BATCHES);
+  const MeanEstimate reference = weightedMean(refRects, refLogWeights);
+  const MeanEstimate unweighted = sampleMean(refRects);
+
+  char detail[128];
+  bool ok = invalid == 0;
+  std::printf("CHECK: grids=%zu invalid=%zu reference=%zu seed=%llu jumps=%llu accepted=%llu\n", count,
+              invalid, refCount, (unsigned long long)seed, (unsigned long long)sampler.jumpsProposed(),
+              (unsigned long long)sampler.jumpsAccepted());
+  std::snprintf(detail, sizeof(detail), "(chi2=%.1f dof=648)", chi2);
+  ok = report("cells", chiSquareZ(chi2, 648.0), detail) && ok;
+  std::snprintf(detail, sizeof(detail), "(equal=%.5f expected=%.5f)", (double)equalCells / pairs, 1.0 / 9.0);
+  ok = report("pairs", equalZ, detail) && ok;
+  std::snprintf(detail, sizeof(detail), "(mean=%.3f reference=%.3f)", sampled.mean, reference.mean);
+  ok = report("structure", meanZ(sampled, reference), detail) && ok;
+  std::printf("INFO:  unweighted fills structure z=%.2f (mean=%.3f)\n", meanZ(unweighted, reference),
+              unweighted.mean);
+  std::printf("CHECK: %s\n", ok ? "PASSED" : "FAILED");
+  return ok ? 0 : 1;
+}
+
+// Folds a grid into the checksum of the stream, 8 digits per step: the same in both
+// modes for a seed, so a --summary run vouches for the printed grids too (and keeps
+// its sampling loop from being optimized away).
+static uint64_t gridChecksum(uint64_t checksum, const Digit grid[81]) {
+  for (int i = 0; i < 80; i += 8) {
+    uint64_t word;
+    std::memcpy(&word, grid + i, sizeof(word));
+    checksum = (checksum ^ word) * 0x100000001B3ull;
+  }
+  return (checksum ^ grid[80]) * 0x100000001B3ull;
+}
+
+static void usage(const char *argv0) {
+  std::cerr
+      << "Usage: " << argv0 << " [--count=N] [--seed=S] [--swaps=K] [--jump=J] [--check] [--summary]\n"
+      << "  Prints N random solved grids (81 digits per line), then the rate.\n"
+      << "  --count=N  grids to sample (default 1000000)\n"
+      << "  --seed=S   seed of the generator (default 1); the same seed gives the same grids\n"
+      << "  --swaps=K  swap moves of the chain per grid (default 2)\n"
+      << "  --jump=J   one jump of the chain every J grids (default 64, 0 = none)\n"
+      << "  --check    run the bias tests on N grids instead of printing them\n"
+      << "  --summary  print only the rate\n";
+}
+
+int main(int argc, char **argv) {
+  size_t count = 1000000;
+  uint64_t seed = 1;
+  int swaps = 2;
+  int jumpEvery = 64;
+  bool check = false;
+  bool summaryOnly = false;
+  for (int i = 1; i < argc; i++) {
+    std::string a = argv[i];
+    if (a.rfind("--count=", 0) == 0) {
+      count = (size_t)std::strtoull(a.c_str() + std::strlen("--count="), nullptr, 10);
+    } else if (a.rfind("--seed=", 0) == 0) {
+      seed = (uint64_t)std::strtoull(a.c_str() + std::strlen("--seed="), nullptr, 10);
+    } else if (a.rfind("--swaps=", 0) == 0) {
+      swaps = std::atoi(a.c_str() + std::strlen("--swaps="));
+    } else if (a.rfind("--jump=", 0) == 0) {
+      jumpEvery = std::atoi(a.c_str() + std::strlen("--jump="));
+    } else if (a == "--check") {
+      check = true;
+    } else if (a == "--summary") {
+      summaryOnly = true;
+    } else {
+      std::cerr << "Unknown option: " << a << "\n";
+      usage(argv[0]);
+      return 2;
+    }
+  }
+  if (count == 0 || (check && count < 2 * CHECK_BATCHES) || swaps < 0 || jumpEvery < 0) {
+    usage(argv[0]);
+    return 2;
+  }
+
+  if (check) {
+    return runCheck(seed, count, swaps, jumpEvery);
+  }
+
+  GridSampler sampler(seed, swaps, jumpEvery);
+  Digit grid[81];
+  char line[83];
+  line[81] = '\n';
+  line[82] = '\0';
+  uint64_t checksum = 0;
+  const auto t0 = std::chrono::steady_clock::now();
+  for (size_t n = 0; n < count; n++) {
+    sampler.next(grid);
+    checksum = gridChecksum(checksum, grid);
+    if (summaryOnly) {
+      continue;
+    }
+    for (int i = 0; i < 81; i++) {
+      line[i] = (char)('0' + grid[i]);
+    }
+    std::fputs(line, stdout);
+  }
+  const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+  std::fprintf(summaryOnly ? stdout : stderr, "SAMPLE: grids=%zu seed=%llu swaps=%d jump=%d checksum=%llu\n",
+               count, (unsigned long long)seed, swaps, jumpEvery, (unsigned long long)checksum);
+  std::fprintf(summaryOnly ? stdout : stderr, "RATE: seconds=%.3f grids_per_sec=%.1f\n", seconds,
+               seconds > 0 ? (double)count / seconds : 0.0);
+  return 0;
+}
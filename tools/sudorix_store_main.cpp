@@ -0,0 +1,300 @@
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "solver.hpp"
+#include "MaskBoard.hpp"
+#include "job_pool.hpp"
+#include "solution_store.hpp"
+
+// Solution store builder and lookup.
+//
+//   build <puzzles.txt> <store.bin>  solves every puzzle and writes the store: the
+//     tier comes from the technique tiers run one after the other (as in the
+//     classifier), the solution from the last of them, or from a search for the
+//     puzzles the techniques do not finish. Puzzles without a unique solution are
+//     left out. The number after a puzzle on its line (catalogue rating, e.g. 7.2)
+//     is kept in tenths as its rating.
+//   lookup <puzzles.txt> <store.bin>  looks every puzzle up and reports the hit rate
+//     and the cost of a lookup.
+// Both commands take the puzzles first and the store second.
+//
+// The input is read in blocks of BUILD_BLOCK puzzles, each solved over the worker
+// threads and then inserted, so a catalogue never has to fit in memory; the store is
+// sized by a first pass that only counts the puzzles.
+
+static constexpr size_t BUILD_BLOCK = 1 << 16;
+
+struct StoreItem {
+  size_t lineNo;
+  char in81[82];
+  char solution[82];
+  uint16_t rating;
+  uint8_t tier;
+  int solutions;  // 0, 1, 2 = two or more, -1 = invalid
+};
+
+// "<81 symbols> [rating]": the first 81 symbols (digits, '.') are the puzzle, the next
+// number on the line, if any, its rating.
+static bool loadPuzzle(const std::string &line, StoreItem *item) {
+  size_t n = 0;
+  size_t pos = 0;
+  for (; pos < line.size() && n < 81; pos++) {
+    const char c = line[pos];
+    if (c == '.' || (c >= '0' && c <= '9')) {
+      item->in81[n++] = c;
+    } else if (c == '#') {
+      break;
+    }
+  }
+  if (n != 81) {
+    return false;
+  }
+  item->in81[81] = '\0';
+  item->rating = 0;
+  const size_t num = line.find_first_of("0123456789", pos);
+  if (num != std::string::npos && line.find('#', pos) > num) {
+    const double r = std::strtod(line.c_str() + num, nullptr) * 10.0 + 0.5;
+    item->rating = (uint16_t)std::min(65535.0, std::max(0.0, r));
+  }
+  return true;
+}
+
+static void solveOne(StoreItem &item) {
+  uint8_t values[81];
+  uint16_t cands[81];
+  item.tier = 0;
+  item.solutions = -1;
+  if (!sudorix_solver_parse_board(item.in81, values, cands)) {
+    return;
+  }
+  for (uint32_t tier = SUDORIX_TIER_SINGLES; tier <= SUDORIX_TIER_MAX; tier++) {
+    sudorix_solver_run_tier(values, cands, tier);
+    if (std::find(values, values + 81, 0) == values + 81) {
+      item.tier = (uint8_t)tier;
+      break;
+    }
+  }
+
+  if (item.tier == 0) {
+    // the techniques prove uniqueness when they finish; a search has to check it
+    Digit givens[81];
+    for (int i = 0; i < 81; i++) {
+      const char c = item.in81[i];
+      givens[i] = (c >= '1' && c <= '9') ? (Digit)(c - '0') : 0;
+    }
+    MaskBoard board;
+    if (!board.init(givens)) {
+      return;
+    }
+    item.solutions = board.propagate() ? board.countSolutions(2, values) : 0;
+  } else {
+    item.solutions = 1;
+  }
+  if (item.solutions == 1) {
+    for (int i = 0; i < 81; i++) {
+      item.solution[i] = (char)('0' + values[i]);
+    }
+    item.solution[81] = '\0';
+  }
+}
+
+static void usage(const char *argv0) {
+  std::cerr
+      << "Usage: " << argv0 << " build <sudoku_file.txt> <store.bin> [--jobs=N] [--chunk=N] [--pin]\n"
+      << "       " << argv0 << " lookup <sudoku_file.txt> <store.bin> [--summary]\n"
+      << "  build   solves every puzzle and writes the store (solution, tier, rating)\n"
+      << "  lookup  prints '<puzzle> <solution> <tier> <rating>' or '<puzzle> miss' per puzzle,\n"
+      << "          then the totals and the cost of a lookup\n"
+      << "  --jobs=N   build: solve over N worker threads (0 = hardware concurrency)\n"
+      << "  --chunk=N  build: puzzles handed to a worker at a time (default 64)\n"
+      << "  --pin      build: pin each worker thread to its own CPU (Linux)\n"
+      << "  --summary  lookup: print only the totals\n";
+}
+
+static int build(const std::string &path, const std::string &storePath, unsigned jobs, size_t chunkSize,
+                 bool pinWorkers) {
+  std::ifstream fin(path);
+  if (!fin) {
+    std::cerr << "Failed to open file: " << path << "\n";
+    return 2;
+  }
+  size_t expected = 0;
+  std::string line;
+  StoreItem item;
+  while (std::getline(fin, line)) {
+    expected += loadPuzzle(line, &item) ? 1 : 0;
+  }
+  fin.clear();
+  fin.seekg(0);
+
+  SolutionStore store;
+  if (!store.create(storePath.c_str(), expected)) {
+    std::cerr << "Failed to create store: " << storePath << "\n";
+    return 2;
+  }
+
+  size_t total = 0;
+  size_t invalid = 0;
+  size_t notUnique = 0;
+  size_t failed = 0;
+  size_t tiers[SUDORIX_TIER_MAX + 1] = {};
+  std::vector<StoreItem> block;
+  block.reserve(BUILD_BLOCK);
+  size_t lineNo = 0;
+  const auto t0 = std::chrono::steady_clock::now();
+  while (fin) {
+    block.clear();
+    while (block.size() < BUILD_BLOCK && std::getline(fin, line)) {
+      lineNo++;
+      if (loadPuzzle(line, &item)) {
+        item.lineNo = lineNo;
+        block.push_back(item);
+      }
+    }
+
+    const auto solveRange = [&](size_t begin, size_t end) {
+      for (size_t i = begin; i < end; i++) {
+        solveOne(block[i]);
+      }
+    };
+    if (jobs <= 1) {
+      solveRange(0, block.size());
+    } else {
+      JobPool pool(jobs, pinWorkers);
+      pool.run(block.size(), chunkSize, solveRange);
+    }
+
+    for (const StoreItem &it : block) {
+      total++;
+      if (it.solutions < 0) {
+        invalid++;
+        std::cerr << "line " << it.lineNo << ": invalid puzzle\n";
+      } else if (it.solutions != 1) {
+        notUnique++;
+      } else if (store.insert(it.in81, it.solution, it.tier, it.rating)) {
+        tiers[it.tier]++;
+      } else {
+        failed++;
+        std::cerr << "line " << it.lineNo << ": insert failed\n";
+      }
+    }
+  }
+  const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+  const size_t stored = store.size();
+  const size_t slots = store.capacity();
+  const size_t bytes = store.fileSize();
+  if (!store.close()) {
+    std::cerr << "Failed to write store: " << storePath << "\n";
+    return 2;
+  }
+  std::cout << "STORE: total=" << total << " stored=" << stored << " invalid=" << invalid
+            << " not_unique=" << notUnique << " failed=" << failed << " tier0=" << tiers[0];
+  for (uint32_t t = SUDORIX_TIER_SINGLES; t <= SUDORIX_TIER_MAX; t++) {
+    std::cout << " tier" << t << "=" << tiers[t];
+  }
+  std::cout << " slots=" << slots << " bytes=" << bytes << "\n";
+  std::printf("RATE: seconds=%.3f puzzles_per_sec=%.1f\n", seconds, seconds > 0 ? (double)total / seconds : 0.0);
+  return failed ? 1 : 0;
+}
+
+static int lookup(const std::string &path, const std::string &storePath, bool summaryOnly) {
+  SolutionStore store;
+  if (!store.open(storePath.c_str())) {
+    std::cerr << "Failed to open store: " << storePath << "\n";
+    return 2;
+  }
+  std::ifstream fin(path);
+  if (!fin) {
+    std::cerr << "Failed to open file: " << path << "\n";
+    return 2;
+  }
+  std::vector<StoreItem> items;
+  std::string line;
+  StoreItem item;
+  while (std::getline(fin, line)) {
+    if (loadPuzzle(line, &item)) {
+      items.push_back(item);
+    }
+  }
+
+  std::vector<SolutionStore::Entry> entries(items.size());
+  std::vector<uint8_t> hit(items.size());
+  const auto t0 = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < items.size(); i++) {
+    hit[i] = store.lookup(items[i].in81, &entries[i]) ? 1 : 0;
+  }
+  const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+  size_t hits = 0;
+  for (size_t i = 0; i < items.size(); i++) {
+    hits += hit[i];
+    if (summaryOnly) {
+      continue;
+    }
+    if (hit[i]) {
+      std::cout << items[i].in81 << " " << std::string(entries[i].solution, 81) << " "
+                << (int)entries[i].tier << " " << entries[i].rating << "\n";
+    } else {
+      std::cout << items[i].in81 << " miss\n";
+    }
+  }
+  std::cout << "LOOKUP: total=" << items.size() << " hits=" << hits << " misses=" << items.size() - hits
+            << " entries=" << store.size() << " slots=" << store.capacity() << "\n";
+  std::printf("RATE: seconds=%.3f lookups_per_sec=%.1f ns_per_lookup=%.1f\n", seconds,
+              seconds > 0 ? (double)items.size() / seconds : 0.0,
+              items.empty() ? 0.0 : seconds * 1e9 / (double)items.size());
+  return 0;
+}
+
+int main(int argc, char **argv) {
+  if (argc < 4) {
+    usage(argv[0]);
+    return 2;
+  }
+
+  const std::string command = argv[1];
+  bool summaryOnly = false;
+  bool pinWorkers = false;
+  unsigned jobs = 1;
+  size_t chunkSize = 64;
+  for (int i = 4; i < argc; i++) {
+    std::string a = argv[i];
+    if (a == "--summary") {
+      summaryOnly = true;
+    } else if (a == "--pin") {
+      pinWorkers = true;
+    } else if (a.rfind("--jobs=", 0) == 0) {
+      jobs = (unsigned)std::strtoul(a.c_str() + std::strlen("--jobs="), nullptr, 10);
+      if (jobs == 0) {
+        jobs = std::max(1u, std::thread::hardware_concurrency());
+      }
+    } else if (a.rfind("--chunk=", 0) == 0) {
+      chunkSize = std::max<size_t>(1, (size_t)std::strtoul(a.c_str() + std::strlen("--chunk="), nullptr, 10));
+    } else {
+      std::cerr << "Unknown option: " << a << "\n";
+      usage(argv[0]);
+      return 2;
+    }
+  }
+
+  if (command == "build") {
+    return build(argv[2], argv[3], jobs, chunkSize, pinWorkers);
+  }
+  if (command == "lookup") {
+    return lookup(argv[2], argv[3], summaryOnly);
+  }
+  std::cerr << "Unknown command: " << command << "\n";
+  usage(argv[0]);
+  return 2;
+}